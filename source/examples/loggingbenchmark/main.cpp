@@ -0,0 +1,480 @@
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/AsyncLogHandler.h>
+#include <loggingzeug/BinaryLogHandler.h>
+#include <loggingzeug/ConsoleLogHandler.h>
+#include <loggingzeug/FileLogHandler.h>
+#include <loggingzeug/LogContext.h>
+#include <loggingzeug/RotatingFileLogHandler.h>
+#include <loggingzeug/formatString.h>
+#include <loggingzeug/logging.h>
+
+
+using namespace loggingzeug;
+
+
+namespace
+{
+
+
+const std::string logfile = "loggingbenchmark.log";
+const std::string binaryLogfile = "loggingbenchmark.lzb";
+
+
+// Discards everything, so that the console handler is measured without the terminal
+class NullBuffer : public std::streambuf
+{
+protected:
+    virtual int overflow(int c) override
+    {
+        return c;
+    }
+
+    virtual std::streamsize xsputn(const char * /*s*/, std::streamsize count) override
+    {
+        return count;
+    }
+};
+
+// Counts messages instead of writing them, so that only the cost of the log statements is measured
+class CountingLogHandler : public AbstractLogHandler
+{
+public:
+    CountingLogHandler()
+    : count(0)
+    {
+    }
+
+    virtual void handle(const LogMessage & /*message*/) override
+    {
+        ++count;
+    }
+
+    size_t count;
+};
+
+// Reference implementation: the message is formatted by a shared std::stringstream
+class StreamMessageBuilder
+{
+public:
+    StreamMessageBuilder(AbstractLogHandler * handler)
+    : m_handler(handler)
+    , m_stream(std::make_shared<std::stringstream>())
+    {
+    }
+
+    ~StreamMessageBuilder()
+    {
+        if (m_stream.use_count() == 1)
+            m_handler->handle(LogMessage(LogMessage::Info, m_stream->str(), "benchmark"));
+    }
+
+    template <typename T>
+    StreamMessageBuilder & operator<<(const T & value)
+    {
+        *m_stream << value;
+        return *this;
+    }
+
+protected:
+    AbstractLogHandler * m_handler;
+    std::shared_ptr<std::stringstream> m_stream;
+};
+
+// Reference implementation: the format string is parsed on every call and the values are written by a std::stringstream
+void streamFormat(std::ostream & stream, const char * format)
+{
+    stream << format;
+}
+
+template <typename T, typename... Args>
+void streamFormat(std::ostream & stream, const char * format, const T & value, const Args &... args)
+{
+    while (*format)
+    {
+        if (*format == '%' && *++format != '%')
+        {
+            const auto flags = stream.flags();
+            parseFormat(stream, format);
+            stream << value;
+            stream.flags(flags);
+            streamFormat(stream, format, args...);
+            return;
+        }
+
+        stream << *format++;
+    }
+}
+
+template <typename... Args>
+std::string streamFormatString(const char * format, const Args &... args)
+{
+    std::stringstream stream;
+    streamFormat(stream, format, args...);
+    return stream.str();
+}
+
+// Returns the average duration of a single call in nanoseconds
+double measure(size_t repetitions, const std::function<void(size_t)> & function)
+{
+    function(0); // warm up
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (auto i = static_cast<size_t>(0); i < repetitions; ++i)
+    {
+        function(i);
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+// Returns the size of a file in bytes
+long fileSize(const std::string & filename)
+{
+    const auto file = std::fopen(filename.c_str(), "rb");
+
+    if (!file)
+    {
+        return 0;
+    }
+
+    std::fseek(file, 0, SEEK_END);
+    const auto size = std::ftell(file);
+    std::fclose(file);
+
+    return size;
+}
+
+// Returns the number of messages per second logged by all producers together
+double throughput(size_t producers, size_t messages, const std::function<void()> & finish = nullptr)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    auto threads = std::vector<std::thread>();
+
+    for (auto p = static_cast<size_t>(0); p < producers; ++p)
+    {
+        threads.emplace_back([p, producers, messages] () {
+            for (auto i = p; i < messages; i += producers)
+            {
+                info("benchmark") << "Message " << i << " from producer " << p << ", value " << 0.5 * i;
+            }
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    if (finish)
+    {
+        finish();
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return messages / std::chrono::duration<double>(end - start).count();
+}
+
+void report(const std::string & name, size_t producers, double messagesPerSecond)
+{
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(6) << producers << " producers "
+              << std::setw(14) << std::fixed << std::setprecision(0) << messagesPerSecond << " messages/s" << std::endl;
+}
+
+void report(const std::string & name, double nanoseconds)
+{
+    std::cout << std::left << std::setw(57) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(2) << nanoseconds << " ns/statement" << std::endl;
+}
+
+
+} // namespace
+
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+    const auto producerCounts = { 1, 2, 4, 8, 16, 32 };
+
+
+    // Handlers writing on the logging threads versus the asynchronous handler
+
+    for (const auto producers : producerCounts)
+    {
+        const auto messages = static_cast<size_t>(50000);
+
+        std::remove(logfile.c_str());
+
+        NullBuffer nullBuffer;
+        const auto coutBuffer = std::cout.rdbuf(&nullBuffer);
+
+        setLoggingHandler(new ConsoleLogHandler);
+        const auto console = throughput(producers, messages);
+
+        std::cout.rdbuf(coutBuffer);
+        report("ConsoleLogHandler (discarded output)", producers, console);
+
+        setLoggingHandler(new FileLogHandler(logfile));
+        report("FileLogHandler", producers, throughput(producers, messages));
+
+        for (const auto policy : { RotatingFileLogHandler::SyncPolicy::Never, RotatingFileLogHandler::SyncPolicy::PerBatch })
+        {
+            const auto handler = new RotatingFileLogHandler(logfile, 1 << 20, 2);
+            handler->setSyncPolicy(policy);
+            setLoggingHandler(handler);
+
+            const auto result = throughput(producers, messages, [handler] () { handler->flush(); });
+
+            report(policy == RotatingFileLogHandler::SyncPolicy::Never ? "RotatingFileLogHandler" : "RotatingFileLogHandler, sync per batch", producers, result);
+        }
+
+        for (const auto policy : { AsyncLogHandler::OverflowPolicy::Block, AsyncLogHandler::OverflowPolicy::DropOldest })
+        {
+            const auto handler = new AsyncLogHandler(logfile, 8192, policy);
+            setLoggingHandler(handler);
+
+            const auto result = throughput(producers, messages, [handler] () { handler->flush(); });
+
+            report(policy == AsyncLogHandler::OverflowPolicy::Block ? "AsyncLogHandler, block" : "AsyncLogHandler, drop oldest", producers, result);
+
+            if (handler->droppedMessages() > 0)
+            {
+                std::cout << "(" << handler->droppedMessages() << " messages dropped)" << std::endl;
+            }
+        }
+
+        std::cout << std::endl;
+    }
+
+
+    // Disabled versus enabled debug statements
+
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        const auto handler = new CountingLogHandler;
+        setLoggingHandler(handler);
+
+        for (const auto verbosity : { LogMessage::Warning, LogMessage::Info })
+        {
+            setVerbosityLevel(verbosity);
+
+            const auto state = std::string(verbosity == LogMessage::Warning ? "disabled" : "enabled");
+
+            report("debug() << ..., " + state, measure(repetitions, [] (size_t i) {
+                debug("benchmark") << "Iteration " << i << ", value " << 0.5 * i;
+            }));
+
+            report("LOGGINGZEUG_DEBUG() << ..., " + state, measure(repetitions, [] (size_t i) {
+                LOGGINGZEUG_DEBUG("benchmark") << "Iteration " << i << ", value " << 0.5 * i;
+            }));
+
+            report("fDebug(...), " + state, measure(repetitions, [] (size_t i) {
+                fDebug("Iteration %;, value %;", i, 0.5 * i);
+            }));
+        }
+
+        std::cout << "(" << handler->count << " messages)" << std::endl << std::endl;
+    }
+
+
+    // Per-context verbosity levels and rate limiting
+
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        const auto handler = new CountingLogHandler;
+        setLoggingHandler(handler);
+        setVerbosityLevel(LogMessage::Warning);
+
+        const auto renderer = LogContext("renderer");
+        renderer.setVerbosityLevel(LogMessage::Debug);
+
+        report("debug(\"renderer\") << ..., enabled by context", measure(repetitions, [] (size_t i) {
+            debug("renderer") << "Iteration " << i;
+        }));
+
+        report("debug(LogContext) << ..., enabled by context", measure(repetitions, [&renderer] (size_t i) {
+            debug(renderer) << "Iteration " << i;
+        }));
+
+        report("debug(\"network\") << ..., disabled", measure(repetitions, [] (size_t i) {
+            debug("network") << "Iteration " << i;
+        }));
+
+        report("LOGGINGZEUG_RATE_LIMITED(Warning, 1000, 100) warning() << ...", measure(repetitions, [] (size_t i) {
+            LOGGINGZEUG_RATE_LIMITED(LogMessage::Warning, 1000, 100) warning("network") << "Iteration " << i;
+        }));
+
+        renderer.resetVerbosityLevel();
+
+        report("LOGGINGZEUG_RATE_LIMITED(Debug, 1000, 100) debug() << ..., disabled", measure(repetitions, [] (size_t i) {
+            LOGGINGZEUG_RATE_LIMITED(LogMessage::Debug, 1000, 100) debug("network") << "Iteration " << i;
+        }));
+
+        setVerbosityLevel(LogMessage::Info);
+
+        std::cout << "(" << handler->count << " messages)" << std::endl << std::endl;
+    }
+
+
+    // Fanning out to several handlers with their own verbosity levels
+
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        const auto first = new CountingLogHandler;
+        setLoggingHandler(first);
+
+        report("info() << ..., 1 handler", measure(repetitions, [] (size_t i) {
+            info("benchmark") << "Iteration " << i << ", value " << 0.5 * i;
+        }));
+
+        const auto second = new CountingLogHandler;
+        const auto third = new CountingLogHandler;
+        addLoggingHandler(second, LogMessage::Warning);
+        addLoggingHandler(third, LogMessage::Warning);
+
+        report("info() << ..., 3 handlers, 2 at warning level", measure(repetitions, [] (size_t i) {
+            info("benchmark") << "Iteration " << i << ", value " << 0.5 * i;
+        }));
+
+        addLoggingHandler(second, LogMessage::Info);
+        addLoggingHandler(third, LogMessage::Info);
+
+        report("info() << ..., 3 handlers", measure(repetitions, [] (size_t i) {
+            info("benchmark") << "Iteration " << i << ", value " << 0.5 * i;
+        }));
+
+        std::cout << "(" << first->count + second->count + third->count << " messages)" << std::endl << std::endl;
+    }
+
+
+    // Formatting messages with a std::stringstream versus the LogMessageBuilder
+
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        const auto handler = new CountingLogHandler;
+        setLoggingHandler(handler);
+        setVerbosityLevel(LogMessage::Info);
+
+        const auto text = std::string(300, '-');
+
+        report("std::stringstream, integers", measure(repetitions, [handler] (size_t i) {
+            StreamMessageBuilder(handler) << "Iteration " << i << " of " << 1000000 << ", offset " << -static_cast<int>(i);
+        }));
+
+        report("LogMessageBuilder, integers", measure(repetitions, [] (size_t i) {
+            info("benchmark") << "Iteration " << i << " of " << 1000000 << ", offset " << -static_cast<int>(i);
+        }));
+
+        report("std::stringstream, floating point", measure(repetitions, [handler] (size_t i) {
+            StreamMessageBuilder(handler) << "Position " << 0.5 * i << ", " << std::setprecision(3) << 0.25 * i;
+        }));
+
+        report("LogMessageBuilder, floating point", measure(repetitions, [] (size_t i) {
+            info("benchmark") << "Position " << 0.5 * i << ", " << std::setprecision(3) << 0.25 * i;
+        }));
+
+        report("std::stringstream, 300 characters", measure(repetitions, [handler, &text] (size_t /*i*/) {
+            StreamMessageBuilder(handler) << text;
+        }));
+
+        report("LogMessageBuilder, 300 characters", measure(repetitions, [&text] (size_t /*i*/) {
+            info("benchmark") << text;
+        }));
+
+        std::cout << "(" << handler->count << " messages)" << std::endl << std::endl;
+    }
+
+
+    // Format strings parsed on every call versus compiled formats
+
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        const auto handler = new CountingLogHandler;
+        setLoggingHandler(handler);
+        setVerbosityLevel(LogMessage::Info);
+
+        auto length = static_cast<size_t>(0);
+
+        report("std::stringstream, parsed format", measure(repetitions, [&length] (size_t i) {
+            length += streamFormatString("Iteration %; of %;, offset %#x;, value %rf?_10.2;", i, 1000000, i, 0.5 * i).size();
+        }));
+
+        report("formatString", measure(repetitions, [&length] (size_t i) {
+            length += formatString("Iteration %; of %;, offset %#x;, value %rf?_10.2;", i, 1000000, i, 0.5 * i).size();
+        }));
+
+        report("info() << formatString(...), parsed format", measure(repetitions, [] (size_t i) {
+            info() << streamFormatString("Iteration %; of %;, offset %#x;, value %rf?_10.2;", i, 1000000, i, 0.5 * i);
+        }));
+
+        report("fInfo(...)", measure(repetitions, [] (size_t i) {
+            fInfo("Iteration %; of %;, offset %#x;, value %rf?_10.2;", i, 1000000, i, 0.5 * i);
+        }));
+
+        std::cout << "(" << length << " characters, " << handler->count << " messages)" << std::endl << std::endl;
+    }
+
+
+    // Text files versus binary records, formatted when decoded
+
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        setVerbosityLevel(LogMessage::Info);
+        std::remove(logfile.c_str());
+
+        {
+            const auto handler = new AsyncLogHandler(logfile, 8192, AsyncLogHandler::OverflowPolicy::Block);
+            setLoggingHandler(handler);
+
+            report("fInfo(...), AsyncLogHandler", measure(repetitions, [] (size_t i) {
+                fInfo("Iteration %; of %;, offset %#x;, value %rf?_10.2;", i, 1000000, i, 0.5 * i);
+            }));
+
+            handler->flush();
+        }
+
+        {
+            const auto handler = new BinaryLogHandler(binaryLogfile);
+            setLoggingHandler(handler);
+
+            report("fInfo(...), BinaryLogHandler", measure(repetitions, [] (size_t i) {
+                fInfo("Iteration %; of %;, offset %#x;, value %rf?_10.2;", i, 1000000, i, 0.5 * i);
+            }));
+
+            handler->flush();
+        }
+
+        std::cout << "(" << fileSize(logfile) << " bytes of text, " << fileSize(binaryLogfile) << " bytes of binary records)" << std::endl << std::endl;
+    }
+
+    setLoggingHandler(new ConsoleLogHandler);
+    std::remove(logfile.c_str());
+    std::remove((logfile + ".1").c_str());
+    std::remove((logfile + ".2").c_str());
+    std::remove(binaryLogfile.c_str());
+
+    return 0;
+}
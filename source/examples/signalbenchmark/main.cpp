@@ -0,0 +1,408 @@
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <signalzeug/Delegate.h>
+#include <signalzeug/EventQueue.h>
+#include <signalzeug/Instrumentation.h>
+#include <signalzeug/ScopedConnection.h>
+#include <signalzeug/Signal.h>
+#include <signalzeug/ThreadSafeSignal.h>
+
+
+using namespace signalzeug;
+
+
+namespace
+{
+
+
+// Reference implementation: slots in a hash map, each callback copied before it is called,
+// and a shared state allocated per connection
+class HashMapSignal
+{
+public:
+    typedef std::function<void(int)> Callback;
+
+    HashMapSignal()
+    : m_nextId(1)
+    {
+    }
+
+    std::shared_ptr<unsigned int> connect(Callback callback)
+    {
+        m_callbacks[m_nextId] = callback;
+        return std::make_shared<unsigned int>(m_nextId++);
+    }
+
+    void disconnect(const std::shared_ptr<unsigned int> & connection)
+    {
+        m_callbacks.erase(*connection);
+    }
+
+    void fire(int value)
+    {
+        for (auto & pair : m_callbacks)
+        {
+            Callback callback = pair.second;
+            callback(value);
+        }
+    }
+
+protected:
+    unsigned int m_nextId;
+    std::unordered_map<unsigned int, Callback> m_callbacks;
+};
+
+struct Accumulator
+{
+    Accumulator()
+    : sum(0)
+    {
+    }
+
+    void add(int value)
+    {
+        sum += value;
+    }
+
+    int sum;
+};
+
+int g_sum = 0;
+
+void addToGlobal(int value)
+{
+    g_sum += value;
+}
+
+// Returns the average duration of a single call in nanoseconds
+double measure(size_t repetitions, const std::function<void()> & function)
+{
+    function(); // warm up
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (auto i = static_cast<size_t>(0); i < repetitions; ++i)
+    {
+        function();
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / repetitions;
+}
+
+void report(const std::string & name, size_t slots, double nanoseconds)
+{
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << slots << " slots "
+              << std::setw(14) << std::fixed << std::setprecision(2) << nanoseconds << " ns/call" << std::endl;
+}
+
+
+} // namespace
+
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+    // Fire with a varying number of connected slots
+
+    for (const auto slots : { 0, 1, 10, 1000 })
+    {
+        const auto repetitions = static_cast<size_t>(10000000) / (slots + 10);
+
+        auto sum = 0;
+
+        HashMapSignal reference;
+        Signal<int> signal;
+        ThreadSafeSignal<int> threadSafeSignal;
+
+        for (auto i = 0; i < slots; ++i)
+        {
+            reference.connect([&sum] (int value) { sum += value; });
+            signal.connect([&sum] (int value) { sum += value; });
+            threadSafeSignal.connect([&sum] (int value) { sum += value; });
+        }
+
+        report("fire unordered_map + copy", slots, measure(repetitions, [&] () {
+            reference.fire(1);
+        }));
+
+        report("fire Signal", slots, measure(repetitions, [&] () {
+            signal.fire(1);
+        }));
+
+        report("fire ThreadSafeSignal", slots, measure(repetitions, [&] () {
+            threadSafeSignal.fire(1);
+        }));
+
+        std::cout << "(sum " << sum << ")" << std::endl << std::endl;
+    }
+
+    // Delegate vs. std::function: creating a callable and calling it
+
+    {
+        const auto repetitions = static_cast<size_t>(10000000);
+
+        Accumulator accumulator;
+        auto * object = &accumulator;
+        const auto method = &Accumulator::add;
+        const auto lambda = [&accumulator] (int value) { accumulator.sum += value; };
+
+        std::function<void(int)> function;
+        Delegate<void(int)> delegate;
+
+        report("create std::function free function", 1, measure(repetitions, [&] () {
+            function = std::function<void(int)>(&addToGlobal);
+        }));
+
+        report("create Delegate free function", 1, measure(repetitions, [&] () {
+            delegate = Delegate<void(int)>(&addToGlobal);
+        }));
+
+        report("create std::function lambda", 1, measure(repetitions, [&] () {
+            function = std::function<void(int)>(lambda);
+        }));
+
+        report("create Delegate lambda", 1, measure(repetitions, [&] () {
+            delegate = Delegate<void(int)>(lambda);
+        }));
+
+        report("create std::function member function", 1, measure(repetitions, [&] () {
+            function = std::function<void(int)>([object, method] (int value) { (object->*method)(value); });
+        }));
+
+        report("create Delegate member function", 1, measure(repetitions, [&] () {
+            delegate = Delegate<void(int)>(object, method);
+        }));
+
+        function = std::function<void(int)>([object, method] (int value) { (object->*method)(value); });
+        delegate = Delegate<void(int)>(object, method);
+
+        report("call std::function member function", 1, measure(repetitions, [&] () {
+            function(1);
+        }));
+
+        report("call Delegate member function", 1, measure(repetitions, [&] () {
+            delegate(1);
+        }));
+
+        Signal<int> signal;
+
+        for (auto i = 0; i < 10; ++i)
+        {
+            signal.connect(&accumulator, &Accumulator::add);
+        }
+
+        report("fire Signal member functions", 10, measure(repetitions / 10, [&] () {
+            signal.fire(1);
+        }));
+
+        std::cout << "(sum " << accumulator.sum + g_sum << ")" << std::endl << std::endl;
+    }
+
+    // Connect and immediately disconnect a slot, e.g., an editor that is opened and closed
+
+    for (const auto slots : { 0, 10, 1000 })
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        auto sum = 0;
+
+        HashMapSignal reference;
+        Signal<int> signal;
+        ThreadSafeSignal<int> threadSafeSignal;
+
+        for (auto i = 0; i < slots; ++i)
+        {
+            reference.connect([&sum] (int value) { sum += value; });
+            signal.connect([&sum] (int value) { sum += value; });
+            threadSafeSignal.connect([&sum] (int value) { sum += value; });
+        }
+
+        report("connect/disconnect unordered_map", slots, measure(repetitions, [&] () {
+            reference.disconnect(reference.connect([&sum] (int value) { sum += value; }));
+        }));
+
+        report("connect/disconnect Signal", slots, measure(repetitions, [&] () {
+            signal.connect([&sum] (int value) { sum += value; }).disconnect();
+        }));
+
+        report("ScopedConnection Signal", slots, measure(repetitions, [&] () {
+            ScopedConnection connection(signal.connect([&sum] (int value) { sum += value; }));
+        }));
+
+        report("connect/disconnect ThreadSafeSignal", slots, measure(repetitions / (slots + 1), [&] () {
+            threadSafeSignal.connect([&sum] (int value) { sum += value; }).disconnect();
+        }));
+
+        std::cout << std::endl;
+    }
+
+    // ThreadSafeSignal fired on this thread while another thread connects and disconnects
+
+    {
+        const auto slots = 10;
+
+        std::atomic<int> sum(0);
+        std::atomic<bool> done(false);
+
+        ThreadSafeSignal<int> signal;
+
+        for (auto i = 0; i < slots; ++i)
+        {
+            signal.connect([&sum] (int value) { sum += value; });
+        }
+
+        std::thread churn([&signal, &sum, &done] () {
+            while (!done)
+            {
+                auto connection = signal.connect([&sum] (int value) { sum += value; });
+                connection.disconnect();
+            }
+        });
+
+        report("fire ThreadSafeSignal with churn", slots, measure(100000, [&] () {
+            signal.fire(1);
+        }));
+
+        done = true;
+        churn.join();
+
+        std::cout << "(sum " << sum << ")" << std::endl << std::endl;
+    }
+
+    // ThreadSafeSignal fired from several threads at once
+
+    for (const auto threads : { 1, 2, 4, 8 })
+    {
+        const auto slots = 10;
+        const auto repetitions = static_cast<size_t>(200000);
+
+        ThreadSafeSignal<int> signal;
+
+        // Slots without shared state, so that only the contention on the signal is measured
+        for (auto i = 0; i < slots; ++i)
+        {
+            signal.connect([] (int /*value*/) {});
+        }
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> firing;
+
+        for (auto i = 0; i < threads; ++i)
+        {
+            firing.emplace_back([&signal, repetitions] () {
+                for (auto k = static_cast<size_t>(0); k < repetitions; ++k)
+                {
+                    signal.fire(1);
+                }
+            });
+        }
+
+        for (auto & thread : firing)
+        {
+            thread.join();
+        }
+
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        report("fire ThreadSafeSignal on " + std::to_string(threads) + " threads", slots,
+            std::chrono::duration<double, std::nano>(end - start).count() / repetitions);
+    }
+
+    std::cout << std::endl;
+
+    // Emission on a worker thread, delivered on this thread through an EventQueue
+
+    for (const auto delivery : { Delivery::Queued, Delivery::Coalesced })
+    {
+        const auto emissions = static_cast<size_t>(100000);
+
+        auto sum = 0;
+
+        EventQueue queue;
+        Signal<int> signal;
+
+        signal.connect(queue, [&sum] (int value) { sum += value; }, delivery);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        std::atomic<bool> finished(false);
+
+        std::thread worker([&signal, &finished, emissions] () {
+            for (auto i = static_cast<size_t>(0); i < emissions; ++i)
+            {
+                signal.fire(1);
+            }
+
+            finished = true;
+        });
+
+        auto delivered = static_cast<size_t>(0);
+
+        while (!finished || !queue.empty())
+        {
+            queue.wait(std::chrono::milliseconds(1));
+            delivered += queue.process();
+        }
+
+        worker.join();
+
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        report(delivery == Delivery::Queued ? "EventQueue queued" : "EventQueue coalesced", 1,
+            std::chrono::duration<double, std::nano>(end - start).count() / emissions);
+
+        std::cout << "(" << delivered << " deliveries for " << emissions << " emissions)" << std::endl << std::endl;
+    }
+
+
+    // Overhead of instrumentation on a chain of forwarded signals
+
+    if (Instrumentation::isCompiledIn())
+    {
+        const auto repetitions = static_cast<size_t>(1000000);
+
+        auto sum = 0;
+
+        Signal<int> first;
+        Signal<int> second;
+        Signal<int> third;
+
+        first.connect(second);
+        second.connect(third);
+        third.connect([&sum] (int value) { sum += value; });
+
+        auto & instrumentation = Instrumentation::instance();
+        instrumentation.setName(&first, "first");
+        instrumentation.setName(&second, "second");
+        instrumentation.setName(&third, "third");
+
+        report("Signal chain, instrumentation off", 3, measure(repetitions, [&first] () { first.fire(1); }));
+
+        instrumentation.setEnabled(true);
+        report("Signal chain, instrumentation on", 3, measure(repetitions, [&first] () { first.fire(1); }));
+        instrumentation.setEnabled(false);
+
+        std::cout << "(sum " << sum << ")" << std::endl << std::endl;
+
+        instrumentation.writeReport(std::cout);
+    }
+    else
+    {
+        std::cout << "Signal instrumentation is compiled out (OPTION_BUILD_WITH_SIGNAL_INSTRUMENTATION)" << std::endl;
+    }
+
+    return 0;
+}
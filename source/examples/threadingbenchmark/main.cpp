@@ -0,0 +1,342 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <threadingzeug/Future.h>
+#include <threadingzeug/parallelfor.h>
+#include <threadingzeug/parallelreduce.h>
+#include <threadingzeug/parallelscan.h>
+#include <threadingzeug/parallelsort.h>
+#include <threadingzeug/TaskGroup.h>
+#include <threadingzeug/ThreadPool.h>
+#include <threadingzeug/Topology.h>
+
+
+using namespace threadingzeug;
+
+
+namespace
+{
+
+
+// Reference implementation: one std::async thread per hardware thread and call
+void asyncParallelFor(size_t start, size_t end, const std::function<void(size_t)> & callback)
+{
+    const auto numberOfThreads = getNumberOfThreads();
+
+    auto futures = std::vector<std::future<void>>(numberOfThreads);
+    const auto step = (end - start + numberOfThreads - 1) / numberOfThreads;
+
+    for (auto i = static_cast<size_t>(0); i < numberOfThreads; ++i)
+    {
+        futures[i] = std::async(std::launch::async, [i, step, start, end, &callback] () {
+            const auto e = std::min(start + (i + 1) * step, end);
+
+            for (auto k = start + i * step; k < e; ++k)
+            {
+                callback(k);
+            }
+        });
+    }
+
+    for (auto & future : futures)
+    {
+        future.wait();
+    }
+}
+
+// Static blocks on the persistent pool, independent of the parallelFor backend
+void poolParallelFor(size_t start, size_t end, const std::function<void(size_t)> & callback)
+{
+    const auto numberOfTasks = ThreadPool::instance().numberOfWorkers();
+    const auto step = (end - start + numberOfTasks - 1) / numberOfTasks;
+
+    TaskGroup group;
+
+    for (auto i = static_cast<size_t>(0); i < numberOfTasks; ++i)
+    {
+        group.run([i, step, start, end, &callback] () {
+            const auto e = std::min(start + (i + 1) * step, end);
+
+            for (auto k = start + i * step; k < e; ++k)
+            {
+                callback(k);
+            }
+        });
+    }
+
+    group.wait();
+}
+
+// Returns the average duration of a single call in microseconds
+double measure(size_t repetitions, const std::function<void()> & function)
+{
+    function(); // warm up
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (auto i = static_cast<size_t>(0); i < repetitions; ++i)
+    {
+        function();
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+}
+
+// Burns roughly 'work' units of CPU time
+float spin(size_t work)
+{
+    auto value = 0.0f;
+
+    for (auto i = static_cast<size_t>(0); i < work; ++i)
+    {
+        value += std::sqrt(static_cast<float>(i));
+    }
+
+    return value;
+}
+
+void report(const std::string & name, size_t iterations, double microseconds)
+{
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << iterations << " iterations "
+              << std::setw(14) << std::fixed << std::setprecision(2) << microseconds << " us/call" << std::endl;
+}
+
+
+} // namespace
+
+
+int main(int argc, char * argv[])
+{
+    // Optional argument: maximum number of elements for the sort benchmark
+    const auto maximumSortSize = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : static_cast<size_t>(100000000);
+
+    const auto topology = Topology::current();
+
+    std::cout << "Topology: " << topology.cpus().size() << " CPUs, " << topology.nodes().size() << " NUMA nodes, "
+              << "CPU quota " << (topology.cpuQuota() > 0.0 ? std::to_string(topology.cpuQuota()) : std::string("none"))
+              << " -> " << getNumberOfThreads() << " threads" << std::endl;
+
+#ifdef USE_OPENMP
+    std::cout << "parallelFor backend: OpenMP" << std::endl;
+#else
+    std::cout << "parallelFor backend: ThreadPool (" << ThreadPool::instance().numberOfWorkers() << " workers)" << std::endl;
+#endif
+    std::cout << std::endl;
+
+    const auto sizes = std::vector<size_t>{ 1000, 100000, 10000000 };
+
+    for (const auto size : sizes)
+    {
+        auto data = std::vector<float>(size);
+        const auto repetitions = std::max(static_cast<size_t>(10), static_cast<size_t>(100000000) / size / 10);
+
+        auto body = [&data] (size_t i) { data[i] = std::sqrt(static_cast<float>(i)); };
+
+        report("std::async per call", size, measure(repetitions, [&] () {
+            asyncParallelFor(0, size, body);
+        }));
+
+        report("ThreadPool", size, measure(repetitions, [&] () {
+            poolParallelFor(0, size, body);
+        }));
+
+        report("parallelFor", size, measure(repetitions, [&] () {
+            parallelFor<size_t>(0, size, body);
+        }));
+
+        report("sequentialFor", size, measure(repetitions, [&] () {
+            sequentialFor<size_t>(0, size, body);
+        }));
+
+        std::cout << std::endl;
+    }
+
+    // Per-iteration overhead of std::function vs. template callables on a trivial saxpy body
+
+    {
+        const auto size = static_cast<size_t>(10000000);
+        const auto a = 2.0f;
+
+        auto x = std::vector<float>(size, 1.0f);
+        auto y = std::vector<float>(size, 2.0f);
+
+        const auto saxpy = [a, &x, &y] (size_t i) { y[i] = a * x[i] + y[i]; };
+        const auto saxpyFunction = std::function<void(size_t)>(saxpy);
+
+        report("saxpy sequentialFor std::function", size, measure(10, [&] () {
+            sequentialFor<size_t>(0, size, saxpyFunction);
+        }));
+
+        report("saxpy sequentialFor template", size, measure(10, [&] () {
+            sequentialFor<size_t>(0, size, saxpy);
+        }));
+
+        report("saxpy parallelFor std::function", size, measure(10, [&] () {
+            parallelFor<size_t>(0, size, saxpyFunction);
+        }));
+
+        report("saxpy parallelFor template", size, measure(10, [&] () {
+            parallelFor<size_t>(0, size, saxpy);
+        }));
+
+        std::cout << std::endl;
+    }
+
+    // Two independent loops, one after the other vs. overlapped via futures
+
+    {
+        const auto size = static_cast<size_t>(1000);
+
+        auto a = std::vector<float>(size);
+        auto b = std::vector<float>(size);
+
+        const auto first = [&a] (size_t i) { a[i] = spin(200); };
+        const auto second = [&b] (size_t i) { b[i] = spin(200); };
+
+        report("two parallelFor in sequence", size, measure(20, [&] () {
+            parallelFor<size_t>(0, size, first);
+            parallelFor<size_t>(0, size, second);
+        }));
+
+        report("two parallelForAsync + whenAll", size, measure(20, [&] () {
+            whenAll(std::vector<Future<void>>{
+                parallelForAsync<size_t>(0, size, first),
+                parallelForAsync<size_t>(0, size, second) }).wait();
+        }));
+
+        std::cout << std::endl;
+    }
+
+    // Reductions and scans
+
+    {
+        const auto size = static_cast<size_t>(10000000);
+
+        auto values = std::vector<float>(size);
+        auto output = std::vector<float>(size);
+
+        for (auto i = static_cast<size_t>(0); i < size; ++i)
+        {
+            values[i] = static_cast<float>(i % 1000) * 0.001f;
+        }
+
+        auto sum = 0.0f;
+
+        report("sum std::accumulate", size, measure(10, [&] () {
+            sum = std::accumulate(values.begin(), values.end(), 0.0f);
+        }));
+
+        report("sum parallelReduce", size, measure(10, [&] () {
+            sum = parallelReduce(values, 0.0f, std::plus<float>());
+        }));
+
+        report("inclusive scan std::partial_sum", size, measure(10, [&] () {
+            std::partial_sum(values.begin(), values.end(), output.begin());
+        }));
+
+        report("inclusive scan parallel", size, measure(10, [&] () {
+            parallelInclusiveScan(values.begin(), values.end(), output.begin(), std::plus<float>());
+        }));
+
+        std::cout << "(sum " << sum << ")" << std::endl << std::endl;
+    }
+
+    // Sorting
+
+    for (auto size = static_cast<size_t>(10000); size <= maximumSortSize; size *= 10)
+    {
+        auto generator = std::mt19937(42);
+        auto keys = std::vector<unsigned int>(size);
+
+        for (auto & key : keys)
+        {
+            key = generator();
+        }
+
+        const auto repetitions = std::max(static_cast<size_t>(1), static_cast<size_t>(10000000) / size);
+
+        // Sorts a fresh copy of the keys per repetition; copying is not measured
+        const auto measureSort = [&keys, repetitions] (const std::function<void(std::vector<unsigned int> &)> & sort) {
+            auto total = 0.0;
+
+            for (auto i = static_cast<size_t>(0); i < repetitions; ++i)
+            {
+                auto values = keys;
+
+                const auto start = std::chrono::high_resolution_clock::now();
+                sort(values);
+                const auto end = std::chrono::high_resolution_clock::now();
+
+                total += std::chrono::duration<double, std::micro>(end - start).count();
+            }
+
+            return total / repetitions;
+        };
+
+        report("std::sort", size, measureSort([] (std::vector<unsigned int> & values) {
+            std::sort(values.begin(), values.end());
+        }));
+
+        report("parallelSort", size, measureSort([] (std::vector<unsigned int> & values) {
+            parallelSort(values.begin(), values.end());
+        }));
+
+        report("std::stable_sort", size, measureSort([] (std::vector<unsigned int> & values) {
+            std::stable_sort(values.begin(), values.end());
+        }));
+
+        report("parallelStableSort", size, measureSort([] (std::vector<unsigned int> & values) {
+            parallelStableSort(values.begin(), values.end());
+        }));
+
+        std::cout << std::endl;
+    }
+
+    // Load balance of the scheduling policies
+
+    const auto schedules = std::vector<std::pair<Schedule, std::string>>{
+        { Schedule::Static,        "Static" },
+        { Schedule::StaticChunked, "StaticChunked (grain 64)" },
+        { Schedule::Dynamic,       "Dynamic (grain 64)" },
+        { Schedule::Guided,        "Guided (grain 16)" }
+    };
+
+    const auto iterations = static_cast<size_t>(20000);
+    auto results = std::vector<float>(iterations);
+
+    const auto uniform = [&results] (size_t i) { results[i] = spin(500); };
+    // The last 10% of the iterations are 50 times as expensive as the others
+    const auto skewed = [&results, iterations] (size_t i) { results[i] = spin(i < iterations * 9 / 10 ? 100 : 5000); };
+
+    for (const auto & workload : { std::make_pair(std::string("uniform"), std::function<void(size_t)>(uniform)),
+                                   std::make_pair(std::string("skewed"), std::function<void(size_t)>(skewed)) })
+    {
+        for (const auto & schedule : schedules)
+        {
+            const auto grainSize = schedule.first == Schedule::Guided ? 16 : 64;
+
+            report(workload.first + " " + schedule.second, iterations, measure(5, [&] () {
+                parallelFor<size_t>(0, iterations, workload.second, schedule.first, grainSize);
+            }));
+        }
+
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
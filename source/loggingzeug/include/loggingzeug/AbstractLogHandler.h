@@ -6,15 +6,17 @@ namespace loggingzeug
 {
 
 class LogMessage;
+class LogRecord;
 
 /** \brief Abstract interface to handle LogMessages.
     
-    loggingzeug uses a global logging handler to dispatch all generated LogMessages.
+    loggingzeug dispatches all generated LogMessages to the registered logging handlers.
     This is the abstract interface for handling them.
-    Subclass this class if you wish to replace the global default logging 
+    Subclass this class if you wish to replace or extend the default logging 
     behavior in loggingzeug, which is to write everything to stdout.
     
     \see setLoggingHandler
+    \see addLoggingHandler
     \see logging.h
  */
 class LOGGINGZEUG_API AbstractLogHandler
@@ -25,6 +27,19 @@ public:
     }
 
 	virtual void handle(const LogMessage& message) = 0;
+
+    /** \brief Handles a message whose formatting was deferred.
+
+        Only called if handlesRecords returns true. The default implementation
+        renders the message and passes it to handle.
+
+        \see LogRecord
+     */
+    virtual void handleRecord(const LogRecord& record);
+
+    /** \brief Returns whether fInfo etc. should pass LogRecords to handleRecord instead of formatting them (default: false)
+     */
+    virtual bool handlesRecords() const;
 };
 
 } // namespace loggingzeug
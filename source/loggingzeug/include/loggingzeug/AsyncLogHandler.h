@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/FileLogHandler.h>
+#include <loggingzeug/LogMessage.h>
+
+namespace loggingzeug
+{
+
+/** \brief Writes LogMessages to a file (default: logfile.log) on a background thread.
+
+    The logging thread only copies the message into a bounded lock-free queue;
+    prefixing and writing happen on a background thread that writes the queued
+    messages in batches to a file that is kept open for the lifetime of the handler.
+
+    When the queue is full, the OverflowPolicy decides whether the logging thread
+    waits for the writer, or whether the new or the oldest queued message is
+    discarded. Discarded messages are counted (see droppedMessages). Waiting
+    logging threads sleep until the writer has taken the next batch of messages.
+
+    Fatal messages are never discarded; they are written and flushed to the file
+    together with all previously queued messages before handle returns.
+
+    \code{.cpp}
+
+        setLoggingHandler(new AsyncLogHandler("service.log", 16384, AsyncLogHandler::OverflowPolicy::DropOldest));
+
+    \endcode
+
+    \see setLoggingHandler
+    \see FileLogHandler
+*/
+class LOGGINGZEUG_API AsyncLogHandler : public FileLogHandler
+{
+public:
+    enum class OverflowPolicy
+    {
+        Block,      ///< Wait until the writer has made room
+        Drop,       ///< Discard the new message
+        DropOldest  ///< Discard the oldest queued message to make room
+    };
+
+public:
+    /** \param capacity Number of queued messages, rounded up to the next power of two
+     */
+    AsyncLogHandler(const std::string & logfile = "logfile.log", size_t capacity = 8192, OverflowPolicy policy = OverflowPolicy::Block);
+    virtual ~AsyncLogHandler();
+
+    AsyncLogHandler(const AsyncLogHandler &) = delete;
+    AsyncLogHandler & operator=(const AsyncLogHandler &) = delete;
+
+    virtual void handle(const LogMessage & message) override;
+
+    /** \brief Blocks until all messages handled so far are written and flushed to the file.
+     */
+    void flush();
+
+    OverflowPolicy overflowPolicy() const;
+    size_t capacity() const;
+
+    /** \return Number of messages discarded because the queue was full
+     */
+    size_t droppedMessages() const;
+
+protected:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        LogMessage::Level level;
+        std::string message;
+        std::string context;
+    };
+
+    bool push(const LogMessage & message);
+    bool pop(std::string & batch);
+    bool dropOldest();
+    bool isFull() const;
+
+    void waitForRoom();
+    void wakeWriter();
+    void wakeBlocked();
+    void run();
+
+protected:
+    const OverflowPolicy m_policy;
+    const size_t m_mask;
+
+    // Bounded queue after Dmitry Vyukov: each slot's sequence tells whether it
+    // is ready to be written (== position) or to be read (== position + 1)
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<size_t> m_tail; // next position to write
+    std::atomic<size_t> m_head; // next position to read
+    std::atomic<size_t> m_dropped;
+
+    std::FILE * m_file;
+    std::thread m_writer;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;   ///< Signaled by the logging threads if the writer is waiting
+    std::condition_variable m_flushed;  ///< Signaled by the writer after flushing the file
+    std::condition_variable m_room;     ///< Signaled by the writer after taking messages if logging threads are blocked
+    std::atomic<bool> m_writerWaiting;
+    std::atomic<size_t> m_blocked;      ///< Number of logging threads waiting for room in the queue
+    std::atomic<size_t> m_flushRequests;
+    size_t m_written;                   ///< Position up to which all messages are written or dropped
+    bool m_stop;
+};
+
+} // namespace loggingzeug
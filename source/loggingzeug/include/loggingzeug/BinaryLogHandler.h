@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/LogMessage.h>
+
+namespace loggingzeug
+{
+
+/** \brief Writes LogRecords in a compact binary form to a file (default: logfile.lzb).
+
+    The handler asks for LogRecords, so messages of fInfo etc. are never
+    formatted by the application: their encoded arguments are written
+    together with the ids of their format string and context. Each format
+    string and context is written once, when first used. Messages streamed
+    into info() etc. are written as text.
+
+    Messages are appended to an existing file, as a new session that the
+    reader continues with. The existing file is read once on construction;
+    an entry cut off at its end, e.g., by a crash, is removed. The file is
+    kept open and written through a large buffer, which is flushed for
+    critical and fatal messages, by flush and on destruction. If the file
+    cannot be opened or is not a compatible binary log, it is left untouched
+    and messages are discarded.
+    The loggingdecoder tool, or a BinaryLogReader, converts the file to text.
+
+    Files are written in the byte order and floating point representation of
+    the writing platform and are meant to be decoded on a similar one.
+
+    \code{.cpp}
+
+        setLoggingHandler(new BinaryLogHandler("service.lzb"));
+        fInfo("Frame %; took %.3f; ms", frame, milliseconds); // encoded, not formatted
+
+    \endcode
+
+    \see BinaryLogReader
+    \see LogRecord
+    \see setLoggingHandler
+*/
+class LOGGINGZEUG_API BinaryLogHandler : public AbstractLogHandler
+{
+public:
+    BinaryLogHandler(const std::string & logfile = "logfile.lzb");
+    virtual ~BinaryLogHandler();
+
+    BinaryLogHandler(const BinaryLogHandler &) = delete;
+    BinaryLogHandler & operator=(const BinaryLogHandler &) = delete;
+
+    virtual void handle(const LogMessage & message) override;
+    virtual void handleRecord(const LogRecord & record) override;
+    virtual bool handlesRecords() const override;
+
+    /** \brief Writes all buffered messages to the file
+     */
+    void flush();
+
+protected:
+    void write(LogMessage::Level level, const std::string & context, const char * format, const std::string & data);
+
+    // Return the id of a format string or context, writing its definition on first use
+    size_t formatId(const char * format);
+    size_t contextId(const std::string & context);
+
+protected:
+    std::FILE * m_file;
+    std::mutex m_mutex;
+
+    std::unordered_map<const char *, size_t> m_formatIds;
+    std::vector<std::string> m_formats;     // by id - 1, to validate cached ids
+    std::unordered_map<std::string, size_t> m_contextIds;
+    std::string m_entry;                    // reused for encoding
+};
+
+} // namespace loggingzeug
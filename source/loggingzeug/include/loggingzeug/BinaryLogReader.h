@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/LogRecord.h>
+
+namespace loggingzeug
+{
+
+/** \brief Reads the LogRecords of a file written by a BinaryLogHandler.
+
+    \code{.cpp}
+
+        BinaryLogReader reader("service.lzb");
+        auto record = LogRecord(LogMessage::Info, nullptr, "", "");
+
+        while (reader.read(record))
+            std::cout << record.message() << std::endl;
+
+    \endcode
+
+    The format strings of the records refer to the reader and stay valid
+    for its lifetime. Reading stops at the end of the file or at the first
+    truncated or corrupt entry; isValid tells these apart afterwards.
+
+    \see BinaryLogHandler
+*/
+class LOGGINGZEUG_API BinaryLogReader
+{
+public:
+    BinaryLogReader(const std::string & logfile);
+    ~BinaryLogReader();
+
+    BinaryLogReader(const BinaryLogReader &) = delete;
+    BinaryLogReader & operator=(const BinaryLogReader &) = delete;
+
+    /** \return false if the file cannot be opened, was not written by a compatible BinaryLogHandler, or is truncated or corrupt
+     */
+    bool isValid() const;
+
+    /** \return Size of the header and the entries read completely, or 0 if the header is invalid
+     */
+    size_t position() const;
+
+    /** \brief Reads the next record
+        \return false at the end of the file, or if it is truncated or corrupt, which makes the reader invalid
+     */
+    bool read(LogRecord & record);
+
+protected:
+    bool readVarint(unsigned long long & value);
+    bool readString(std::string & string);
+    int readByte();
+
+protected:
+    std::FILE * m_file;
+    bool m_valid;
+    size_t m_offset;                        // bytes read
+    size_t m_position;                      // bytes up to the end of the last complete entry
+
+    std::deque<std::string> m_formats;      // by m_formatBase + id - 1; a deque keeps the strings in place
+    std::vector<std::string> m_contexts;    // by m_contextBase + id
+    size_t m_formatBase;                    // definitions before the current session
+    size_t m_contextBase;
+    std::string m_data;
+};
+
+} // namespace loggingzeug
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <ios>
+#include <string>
+#include <vector>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/MessageBuffer.h>
+
+namespace loggingzeug
+{
+
+/** \brief Format string of formatString, parsed once into literal text and format specifiers.
+
+    Writing arguments with a CompiledFormat applies the stream manipulators of
+    each specifier to a MessageBuffer and formats the arguments directly into
+    it, without parsing the format string or involving a std::ostream for
+    strings and numbers. The output is the same as with streamprintf on a
+    fresh std::stringstream.
+
+    Format strings are usually string literals, so cached() keeps the compiled
+    formats of each thread by the address of the format string.
+
+    \code{.cpp}
+
+        MessageBuffer buffer;
+        CompiledFormat::cached("%; of %04;")->write(buffer, "page", 7);
+
+    \endcode
+
+    \see formatString
+*/
+class LOGGINGZEUG_API CompiledFormat
+{
+public:
+    /** \brief Stream manipulators of a single %...; specifier
+     */
+    struct LOGGINGZEUG_API Specifier
+    {
+        Specifier();
+
+        /** \brief Reads a specifier, starting behind the '%', and advances format behind its ';'
+         */
+        static Specifier parse(const char *& format);
+
+        void apply(std::ostream & stream) const;
+        void apply(MessageBuffer & buffer) const;
+
+        std::string text;                       // literal text in front of the specifier, with %% unescaped
+        std::ios_base::fmtflags clearedFlags;
+        std::ios_base::fmtflags setFlags;
+        bool hasFill;
+        char fill;
+        int width;                              // 0 if unchanged
+        int precision;                          // 0 if unchanged
+        size_t end;                             // offset behind the specifier in the format string
+    };
+
+    static const size_t MaximumCacheSize = 1024;
+
+public:
+    explicit CompiledFormat(const char * format);
+
+    /** \brief Returns the compiled format for a format string, compiled on first use by the calling thread
+
+        Hits are validated against the content, so that the address of a
+        formerly cached string may be reused for a different format.
+
+        \return nullptr if format is not cached and the cache is full
+     */
+    static const CompiledFormat * cached(const char * format);
+
+    const std::string & format() const;
+    const std::vector<Specifier> & specifiers() const;
+
+    /** \brief Writes the arguments as formatted by streamprintf
+     */
+    template <typename... Args>
+    void write(MessageBuffer & buffer, const Args &... args) const;
+
+    /** \brief Writes the text in front of an argument and applies its specifier to the buffer
+
+        Together with endArguments, this writes arguments that are only known
+        at runtime: the argument is appended to the buffer, then the flags are
+        restored.
+
+        \param flags Receives the flags to be restored after the argument
+        \return false if there is no specifier left; the rest of the format has been written and further arguments are ignored
+     */
+    bool beginArgument(MessageBuffer & buffer, size_t index, std::ios_base::fmtflags & flags) const;
+
+    /** \brief Writes the rest of the format string behind the given number of arguments as is
+     */
+    void endArguments(MessageBuffer & buffer, size_t count) const;
+
+protected:
+    template <typename T, typename... Args>
+    void writeArguments(MessageBuffer & buffer, size_t index, const T & value, const Args &... args) const;
+    void writeArguments(MessageBuffer & buffer, size_t index) const;
+
+    // Writes literal text; the first character consumes a pending width like a streamed char
+    static void writeText(MessageBuffer & buffer, const std::string & text);
+
+protected:
+    std::string m_format;
+    std::vector<Specifier> m_specifiers;
+    std::string m_text;                         // literal text behind the last specifier, with %% unescaped
+};
+
+namespace detail
+{
+
+// Writes a value into a MessageBuffer as if streamed into a std::ostream
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, bool value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, char value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, signed char value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, unsigned char value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, short value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, unsigned short value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, int value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, unsigned int value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, long value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, unsigned long value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, long long value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, unsigned long long value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, float value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, double value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, long double value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, char * value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, const char * value);
+LOGGINGZEUG_API void formatValue(MessageBuffer & buffer, const std::string & value);
+
+template <typename T>
+void formatValue(MessageBuffer & buffer, const T & value);
+
+} // namespace detail
+
+} // namespace loggingzeug
+
+#include <loggingzeug/CompiledFormat.hpp>
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <loggingzeug/CompiledFormat.h>
+
+namespace loggingzeug
+{
+
+template <typename... Args>
+void CompiledFormat::write(MessageBuffer & buffer, const Args &... args) const
+{
+    writeArguments(buffer, 0, args...);
+}
+
+template <typename T, typename... Args>
+void CompiledFormat::writeArguments(MessageBuffer & buffer, size_t index, const T & value, const Args &... args) const
+{
+    std::ios_base::fmtflags flags;
+
+    if (!beginArgument(buffer, index, flags))
+        return;
+
+    detail::formatValue(buffer, value);
+    buffer.setFlags(flags);
+
+    writeArguments(buffer, index + 1, args...);
+}
+
+namespace detail
+{
+
+template <typename T>
+void formatValue(MessageBuffer & buffer, const T & value)
+{
+    buffer.appendStreamed(value);
+}
+
+} // namespace detail
+
+} // namespace loggingzeug
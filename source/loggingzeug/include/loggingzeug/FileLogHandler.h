@@ -21,6 +21,7 @@ public:
 
 protected:
     static std::string messagePrefix(const LogMessage & message);
+    static std::string messagePrefix(LogMessage::Level level, const std::string & context);
     static std::string levelString(LogMessage::Level level);
 
     std::string m_logfile;
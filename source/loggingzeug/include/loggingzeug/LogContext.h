@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/LogMessage.h>
+
+namespace loggingzeug
+{
+
+/** \brief Handle of a logging context, interned to an integer id on first use.
+
+    Contexts are never removed; the id of a context name stays the same for
+    the lifetime of the process, and the empty default context has id 0.
+    Beyond 262144 contexts, further names are not interned but mapped to the
+    default context.
+    Looking up the verbosity level of a context is a table lookup by its id.
+
+    Creating a LogContext from a name costs a hash lookup, so hot paths
+    should keep the handle instead of passing the name to info() etc.:
+
+    \code{.cpp}
+
+        static const LogContext renderer("renderer");
+
+        renderer.setVerbosityLevel(LogMessage::Debug);
+        debug(renderer) << "Frame " << frame;
+
+    \endcode
+
+    \see setVerbosityLevel
+    \see logging.h
+*/
+class LOGGINGZEUG_API LogContext
+{
+public:
+    /** \brief The default context
+     */
+    LogContext();
+    explicit LogContext(const std::string & name);
+
+    size_t id() const;
+    const std::string & name() const;
+
+    /** \return The verbosity level set for the context, or the global verbosity level
+     */
+    LogMessage::Level verbosityLevel() const;
+    bool hasVerbosityLevel() const;
+
+    /** \brief Sets the verbosity level of the context, which takes precedence over the global one
+     */
+    void setVerbosityLevel(LogMessage::Level verbosity) const;
+
+    /** \brief Makes the context follow the global verbosity level again
+     */
+    void resetVerbosityLevel() const;
+
+    /** \brief Checks if messages of the given level are within the verbosity level of the context
+     */
+    bool includes(LogMessage::Level level) const;
+
+    /** \return The most verbose level of any context, including the global verbosity level
+     */
+    static LogMessage::Level maximumVerbosityLevel();
+
+protected:
+    size_t m_id;
+};
+
+} // namespace loggingzeug
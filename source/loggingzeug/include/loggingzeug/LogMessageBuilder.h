@@ -1,14 +1,17 @@
 #pragma once
 
-#include <sstream>
+#include <ios>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <array>
-#include <memory>
 #include <iomanip>
 
 #include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/LogContext.h>
 #include <loggingzeug/LogMessage.h>
+#include <loggingzeug/LogSinks.h>
+#include <loggingzeug/MessageBuffer.h>
 
 
 namespace loggingzeug
@@ -22,7 +25,15 @@ class AbstractLogHandler;
     log, debug, warning, error or fatal. It works similar to streams and 
     accepts a number of different types which will be converted to strings 
     automatically. When it goes out of scope, it creates a LogMessage from 
-    all streamed objects and sends it to the log handler.
+    all streamed objects and sends it to the logging handlers.
+
+    The message is formatted into a MessageBuffer inside the builder, which
+    only spills to the heap for long messages. Numbers are formatted without
+    iostreams, but honor the same manipulators (precision, fill, width and the
+    flags set by ostream manipulators) as a std::ostream. Builders can be
+    moved, but not copied; nothing is formatted for messages above the
+    verbosity level. For handlers that take LogRecords, messages written by
+    format are not formatted at all, but passed with their arguments.
 
     Typical usage of the LogMessageBuilder:
 	\code{.cpp}
@@ -47,11 +58,17 @@ public:
     using PrecisionManipulator = decltype(std::setprecision(0));
     using FillManipulator = decltype(std::setfill('0'));
     using WidthManipulator = decltype(std::setw(0));
+
 public:
     LogMessageBuilder(LogMessage::Level level, AbstractLogHandler * handler, const std::string & context);
-    LogMessageBuilder(const LogMessageBuilder & builder);
+    LogMessageBuilder(LogMessage::Level level, AbstractLogHandler * handler, const LogContext & context);
+    LogMessageBuilder(LogMessage::Level level, LogSinks && sinks, const LogContext & context);
+    LogMessageBuilder(LogMessageBuilder && builder);
 	virtual ~LogMessageBuilder();
 
+    LogMessageBuilder(const LogMessageBuilder &) = delete;
+    LogMessageBuilder & operator=(const LogMessageBuilder &) = delete;
+
     LogMessageBuilder & operator<<(const char * c);
     LogMessageBuilder & operator<<(const std::string & str);
     LogMessageBuilder & operator<<(bool b);
@@ -70,6 +87,7 @@ public:
 
 	// manipulators
     LogMessageBuilder & operator<<(std::ostream & (*manipulator)(std::ostream&));
+    LogMessageBuilder & operator<<(std::ios_base & (*manipulator)(std::ios_base&));
     LogMessageBuilder & operator<<(PrecisionManipulator manipulator);
     LogMessageBuilder & operator<<(FillManipulator manipulator);
 #ifndef _MSC_VER
@@ -86,11 +104,27 @@ public:
     LogMessageBuilder & operator<<(const std::vector<T> & vector);
     template <typename T, std::size_t Count>
     LogMessageBuilder & operator<<(const std::array<T, Count> & array);
+
+    /** \brief Appends the arguments formatted by a format string of formatString
+
+        If the handler asks for LogRecords and nothing has been streamed into
+        the builder yet, the arguments are only encoded and the formatting is
+        left to the handler.
+     */
+    template <typename... Args>
+    LogMessageBuilder & format(const char * format, const Args &... args);
+protected:
+    // Renders a deferred record into the buffer before text is appended; false if the message is discarded
+    bool beginText();
+    bool isUntouched() const;
+
 protected:
 	LogMessage::Level m_level;
-    AbstractLogHandler * m_handler;
-    std::string m_context;
-    std::shared_ptr<std::stringstream> m_stream;
+    LogSinks m_sinks;               // empty if the message is discarded
+    LogContext m_context;
+    MessageBuffer m_buffer;
+    const char * m_format;          // format string of a deferred LogRecord, or nullptr
+    std::string m_arguments;        // encoded arguments of the deferred LogRecord
 };
 
 } // namespace loggingzeug
@@ -2,6 +2,10 @@
 
 #include <loggingzeug/LogMessageBuilder.h>
 
+#include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/LogRecord.h>
+#include <loggingzeug/formatString.h>
+
 namespace loggingzeug
 {
 
@@ -41,4 +45,27 @@ LogMessageBuilder& LogMessageBuilder::operator<<(const std::array<T, Count> & ar
     return *this;
 }
 
+template <typename... Args>
+LogMessageBuilder& LogMessageBuilder::format(const char * format, const Args &... args)
+{
+    if (m_sinks.isEmpty())
+        return *this;
+
+    if (!m_format && isUntouched() && m_sinks.handlesRecords())
+    {
+        if (LogRecord::encode(m_arguments, args...))
+        {
+            m_format = format;
+            return *this;
+        }
+
+        m_arguments.clear();
+    }
+
+    beginText();
+    bufferprintf(m_buffer, format, args...);
+
+    return *this;
+}
+
 } // namespace loggingzeug
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <string>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/LogMessage.h>
+#include <loggingzeug/MessageBuffer.h>
+
+namespace loggingzeug
+{
+
+/** \brief A log message whose format string and arguments are not yet rendered to text.
+
+    If the logging handler asks for records (see AbstractLogHandler::handlesRecords),
+    LogMessageBuilder::format, and thereby fInfo etc., only encode their
+    arguments into a compact binary form and hand a LogRecord to the handler.
+    The text is rendered later, by the handler or, for a BinaryLogHandler, by
+    the loggingdecoder tool.
+
+    The format string identifies the message statically: it is referenced,
+    not copied, and has to outlive the record, which is the case for string
+    literals. Strings, characters, booleans and arithmetic values are encoded
+    as arguments; for arguments of other types, the message is formatted
+    immediately.
+
+    Encoded arguments are a sequence of a type byte (ArgumentType in the lower
+    four bits, size of integer types in the upper four) and the value:
+    integers as variable-length integers (zigzag-encoded if signed),
+    floating point values in their native representation and strings as
+    their variable-length size followed by the characters.
+
+    \see AbstractLogHandler
+    \see BinaryLogHandler
+    \see formatString
+*/
+class LOGGINGZEUG_API LogRecord
+{
+public:
+    enum class ArgumentType : unsigned char
+    {
+        Boolean,
+        Character,
+        SignedInteger,
+        UnsignedInteger,
+        Double,         ///< Also float
+        LongDouble,
+        String
+    };
+
+public:
+    /** \param format Format string of formatString, or nullptr if arguments holds the text of the message
+     */
+    LogRecord(LogMessage::Level level, const char * format, const std::string & context, const std::string & arguments);
+
+    LogMessage::Level level() const;
+    const char * format() const;
+    const std::string & context() const;
+    const std::string & arguments() const;
+
+    /** \brief Appends the message as formatted by formatString
+     */
+    void render(MessageBuffer & buffer) const;
+    std::string message() const;
+
+    /** \brief Appends the encoded arguments to a string
+        \return false if any argument cannot be encoded, leaving the string partially written
+     */
+    template <typename... Args>
+    static bool encode(std::string & arguments, const Args &... args);
+
+protected:
+    template <typename T, typename... Args>
+    static bool encodeArguments(std::string & arguments, const T & value, const Args &... args);
+    static bool encodeArguments(std::string & arguments);
+
+    // Renders a single argument and advances data behind it; false if the data is malformed
+    static bool renderArgument(MessageBuffer & buffer, const char *& data, const char * end);
+
+protected:
+    LogMessage::Level m_level;
+    const char * m_format;
+    std::string m_context;
+    std::string m_arguments;
+};
+
+namespace detail
+{
+
+// Encodes a value as a LogRecord argument, or returns false for unsupported types
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, bool value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, char value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, signed char value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, unsigned char value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, short value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, unsigned short value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, int value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, unsigned int value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, long value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, unsigned long value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, long long value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, unsigned long long value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, float value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, double value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, long double value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, char * value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, const char * value);
+LOGGINGZEUG_API bool encodeValue(std::string & arguments, const std::string & value);
+
+template <typename T>
+bool encodeValue(std::string & arguments, const T & value);
+
+} // namespace detail
+
+} // namespace loggingzeug
+
+#include <loggingzeug/LogRecord.hpp>
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <loggingzeug/LogRecord.h>
+
+namespace loggingzeug
+{
+
+template <typename... Args>
+bool LogRecord::encode(std::string & arguments, const Args &... args)
+{
+    return encodeArguments(arguments, args...);
+}
+
+template <typename T, typename... Args>
+bool LogRecord::encodeArguments(std::string & arguments, const T & value, const Args &... args)
+{
+    return detail::encodeValue(arguments, value) && encodeArguments(arguments, args...);
+}
+
+namespace detail
+{
+
+template <typename T>
+bool encodeValue(std::string & /*arguments*/, const T & /*value*/)
+{
+    return false;
+}
+
+} // namespace detail
+
+} // namespace loggingzeug
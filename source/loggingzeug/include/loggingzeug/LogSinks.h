@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/LogMessage.h>
+
+namespace loggingzeug
+{
+
+class AbstractLogHandler;
+class LogRecord;
+
+namespace detail
+{
+
+struct LogSinkList;
+
+} // namespace detail
+
+/** \brief The logging handlers (sinks) a message is dispatched to.
+
+    Messages are fanned out to all handlers registered by addLoggingHandler,
+    each of which only receives the messages within its own verbosity level,
+    e.g., a ConsoleLogHandler for warnings and an AsyncLogHandler for
+    everything up to debug messages. A message is formatted once and the
+    same LogMessage is passed to every handler.
+
+    The registered handlers are kept in an immutable list that is replaced on
+    every change (copy-on-write). A LogSinks object pins the current list for
+    the lifetime of a message without locking. Changing the handlers waits
+    until no message uses the replaced list anymore before deleting removed
+    handlers, so handlers must not be added or removed while the same thread
+    builds a message, e.g., from within AbstractLogHandler::handle.
+
+    \see addLoggingHandler
+    \see LogMessageBuilder
+*/
+class LOGGINGZEUG_API LogSinks
+{
+public:
+    /** \brief No handlers; messages are discarded
+     */
+    LogSinks();
+
+    /** \brief A single handler that is used without registering it
+     */
+    explicit LogSinks(AbstractLogHandler * handler);
+
+    LogSinks(LogSinks && sinks);
+    ~LogSinks();
+
+    LogSinks(const LogSinks &) = delete;
+    LogSinks & operator=(const LogSinks &) = delete;
+
+    /** \brief Pins the registered handlers, or none if no handler takes messages of the given level
+     */
+    static LogSinks acquire(LogMessage::Level level);
+
+    bool isEmpty() const;
+
+    /** \brief Returns whether any of the handlers takes LogRecords
+     */
+    bool handlesRecords() const;
+
+    /** \brief Passes the message to the handlers within its level
+     */
+    void handle(const LogMessage & message) const;
+
+    /** \brief Passes the record to the handlers that take LogRecords, and the message rendered once to the others
+     */
+    void handleRecord(const LogRecord & record) const;
+
+    /** \brief Adds a handler, or changes the verbosity level of a registered one, and takes ownership of it
+     */
+    static void add(AbstractLogHandler * handler, LogMessage::Level verbosity);
+
+    /** \brief Removes and deletes a registered handler
+     */
+    static void remove(AbstractLogHandler * handler);
+
+    /** \brief Replaces all registered handlers by the given one (if not nullptr), which takes all messages
+     */
+    static void reset(AbstractLogHandler * handler);
+
+    /** \return The first registered handler, or nullptr
+     */
+    static AbstractLogHandler * first();
+
+    /** \return The most verbose level of any registered handler, or -1 if there is none
+     */
+    static int maximumVerbosityLevel();
+
+protected:
+    template <typename Callback>
+    void dispatch(LogMessage::Level level, Callback callback) const;
+
+protected:
+    const detail::LogSinkList * m_list; // pinned list of registered handlers, or nullptr
+    size_t m_slot;                      // of the reader count that pins the list
+    AbstractLogHandler * m_handler;     // single unregistered handler, or nullptr
+};
+
+} // namespace loggingzeug
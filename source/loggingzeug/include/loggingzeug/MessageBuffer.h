@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <ios>
+#include <ostream>
+#include <string>
+
+#include <loggingzeug/loggingzeug_api.h>
+
+namespace loggingzeug
+{
+
+/** \brief Growable character buffer that formats values like a std::ostream.
+
+    The buffer holds up to InlineCapacity characters without allocating and
+    spills to the heap for longer text. Like a std::ostream, it carries a format
+    state (flags, precision, width and fill), which the append functions honor
+    the same way std::num_put and the character inserters do. Integers are
+    converted by hand and floating point values with snprintf, so that no
+    stream is involved.
+
+    Values of other types are written by appendStreamed through a thread-local
+    std::ostream that takes over the format state of the buffer.
+
+    \see LogMessageBuilder
+    \see formatString
+*/
+class LOGGINGZEUG_API MessageBuffer
+{
+public:
+    static const size_t InlineCapacity = 256;
+
+public:
+    MessageBuffer();
+    MessageBuffer(MessageBuffer && buffer);
+    ~MessageBuffer();
+
+    MessageBuffer(const MessageBuffer &) = delete;
+    MessageBuffer & operator=(const MessageBuffer &) = delete;
+
+    const char * data() const;
+    size_t size() const;
+    std::string str() const;
+    void clear();
+
+    std::ios_base::fmtflags flags() const;
+    void setFlags(std::ios_base::fmtflags flags);
+    std::streamsize precision() const;
+    void setPrecision(std::streamsize precision);
+    std::streamsize width() const;
+    void setWidth(std::streamsize width);
+    char fill() const;
+    void setFill(char fill);
+
+    /** \brief Appends characters without formatting; the width is kept
+     */
+    void append(const char * data, size_t size);
+
+    /** \brief Appends characters like inserting a string into a std::ostream, i.e., padded to the width
+     */
+    void appendText(const char * data, size_t size);
+    void appendCharacter(char c);
+
+    /** \brief Appends an integer like std::num_put
+        \param magnitude Absolute value
+        \param negative Sign
+        \param isSigned 'true' for signed types, which are prefixed by showpos
+        \param size Size of the type in bytes; negative values are written as unsigned of that size in octal and hexadecimal
+     */
+    void appendInteger(unsigned long long magnitude, bool negative, bool isSigned, size_t size);
+    void appendFloat(long double value, bool isLong);
+
+    /** \brief Writes a value of any streamable type, or applies a manipulator, through a std::ostream
+     */
+    template <typename T>
+    void appendStreamed(const T & value);
+
+protected:
+    // Provides a thread-local stream carrying the format state of the buffer while in scope
+    class LOGGINGZEUG_API StreamScope
+    {
+    public:
+        StreamScope(MessageBuffer & buffer);
+        ~StreamScope();
+
+        StreamScope(const StreamScope &) = delete;
+        StreamScope & operator=(const StreamScope &) = delete;
+
+        std::ostream & stream();
+
+    protected:
+        MessageBuffer & m_buffer;
+        std::ostream * m_stream;
+    };
+
+    // Applies and resets the width, padding after the first internalOffset characters for std::internal
+    void appendPadded(const char * data, size_t size, size_t internalOffset);
+
+protected:
+    char * m_data;      // m_inline or a heap buffer
+    size_t m_size;
+    size_t m_capacity;
+    char m_inline[InlineCapacity];
+
+    std::ios_base::fmtflags m_flags;
+    std::streamsize m_precision;
+    std::streamsize m_width;
+    char m_fill;
+};
+
+} // namespace loggingzeug
+
+#include <loggingzeug/MessageBuffer.hpp>
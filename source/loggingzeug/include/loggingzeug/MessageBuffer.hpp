@@ -0,0 +1,16 @@
+#pragma once
+
+#include <loggingzeug/MessageBuffer.h>
+
+namespace loggingzeug
+{
+
+template <typename T>
+void MessageBuffer::appendStreamed(const T & value)
+{
+    StreamScope scope(*this);
+
+    scope.stream() << value;
+}
+
+} // namespace loggingzeug
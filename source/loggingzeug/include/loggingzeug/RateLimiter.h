@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include <loggingzeug/loggingzeug_api.h>
+
+namespace loggingzeug
+{
+
+/** \brief Token bucket that limits the rate of log messages, e.g., of a single call site.
+
+    The bucket holds up to burst tokens and is refilled at the given rate;
+    each message takes a token and is discarded if there is none. The bucket
+    is a single atomic timestamp (the generic cell rate algorithm), so
+    acquire does not lock.
+
+    Usually, a limiter is created per call site by LOGGINGZEUG_RATE_LIMITED.
+
+    \see LOGGINGZEUG_RATE_LIMITED
+*/
+class LOGGINGZEUG_API RateLimiter
+{
+public:
+    /** \param messagesPerSecond Rate at which the bucket is refilled
+        \param burst Capacity of the bucket, i.e., number of messages passed at once
+     */
+    RateLimiter(double messagesPerSecond, size_t burst = 1);
+
+    /** \brief Takes a token
+        \return false if the bucket is empty and the message should be discarded
+     */
+    bool acquire();
+
+    /** \return Number of times acquire returned false
+     */
+    size_t suppressed() const;
+
+protected:
+    const long long m_interval;         // nanoseconds per token
+    const long long m_tolerance;        // (burst - 1) * interval
+    std::atomic<long long> m_next;      // time at which the bucket is full again, in nanoseconds
+    std::atomic<size_t> m_suppressed;
+};
+
+} // namespace loggingzeug
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+#include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/FileLogHandler.h>
+#include <loggingzeug/LogMessage.h>
+
+namespace loggingzeug
+{
+
+/** \brief Writes LogMessages to a file that is rotated by size or age, keeping a number of older generations.
+
+    Unlike the FileLogHandler, the handler keeps the file open and collects
+    messages in a large buffer, which is written to the file when it is full,
+    for critical and fatal messages, by flush, when rotating and on destruction.
+
+    The file is rotated before a message would exceed the maximum size, and
+    before the first message after the rotation interval (if set) has passed.
+    Rotating renames logfile to logfile.1, logfile.1 to logfile.2 and so on,
+    removing the oldest generation, and starts a new logfile.
+
+    The SyncPolicy decides when written messages are forced to the disk.
+
+    \code{.cpp}
+
+        auto handler = new RotatingFileLogHandler("service.log", 64 << 20, 8);
+        handler->setRotationInterval(std::chrono::hours(24));
+        handler->setSyncPolicy(RotatingFileLogHandler::SyncPolicy::OnCritical);
+
+        setLoggingHandler(handler);
+
+    \endcode
+
+    \see setLoggingHandler
+    \see FileLogHandler
+*/
+class LOGGINGZEUG_API RotatingFileLogHandler : public FileLogHandler
+{
+public:
+    enum class SyncPolicy
+    {
+        Never,      ///< Leave it to the operating system
+        PerBatch,   ///< Whenever the buffer is written to the file
+        OnCritical  ///< After critical and fatal messages, and when rotating
+    };
+
+public:
+    /** \param maximumSize Size in bytes at which the file is rotated
+        \param generations Number of rotated files to keep
+        \param bufferSize Size of the buffer in bytes
+     */
+    RotatingFileLogHandler(const std::string & logfile = "logfile.log", size_t maximumSize = 16 << 20, size_t generations = 4, size_t bufferSize = 1 << 18);
+    virtual ~RotatingFileLogHandler();
+
+    RotatingFileLogHandler(const RotatingFileLogHandler &) = delete;
+    RotatingFileLogHandler & operator=(const RotatingFileLogHandler &) = delete;
+
+    virtual void handle(const LogMessage & message) override;
+
+    /** \brief Writes the buffered messages to the file, syncing it unless the policy is Never
+     */
+    void flush();
+
+    size_t maximumSize() const;
+    size_t generations() const;
+
+    /** \brief Rotates the file after the given interval; zero (default) rotates by size only
+     */
+    std::chrono::seconds rotationInterval() const;
+    void setRotationInterval(std::chrono::seconds interval);
+
+    SyncPolicy syncPolicy() const;
+    void setSyncPolicy(SyncPolicy policy);
+
+protected:
+    void open();
+    void rotate();
+
+    // Writes the buffer to the file, syncing it if requested
+    void writeBuffer(bool sync);
+    void sync();
+
+    static std::string generationName(const std::string & logfile, size_t generation);
+
+protected:
+    const size_t m_maximumSize;
+    const size_t m_generations;
+    const size_t m_bufferSize;
+    std::chrono::seconds m_rotationInterval;
+    SyncPolicy m_syncPolicy;
+
+    std::mutex m_mutex;
+    std::FILE * m_file;
+    size_t m_size;                                      // of the file including the buffer
+    std::chrono::steady_clock::time_point m_opened;
+    std::string m_buffer;
+};
+
+} // namespace loggingzeug
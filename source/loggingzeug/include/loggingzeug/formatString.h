@@ -4,6 +4,7 @@
 #include <string>
 
 #include <loggingzeug/loggingzeug_api.h>
+#include <loggingzeug/MessageBuffer.h>
 
 namespace loggingzeug
 {
@@ -15,11 +16,21 @@ LOGGINGZEUG_API void streamprintf(std::ostream& stream, const char* format);
 
 /**
  * Format a number of arguments and prints them to a stream.
+ * The stream's flags, precision, width and fill are used and updated as if the
+ * arguments were streamed into it, but numbers are formatted in the classic locale.
  *
  * \see formatString
  */
 template <typename T, typename... Args>
-void streamprintf(std::ostream& stream, const char* format, const T& value, Args... args);
+void streamprintf(std::ostream& stream, const char* format, const T& value, const Args&... args);
+
+/**
+ * Format a number of arguments and appends them to a MessageBuffer.
+ *
+ * \see formatString
+ */
+template <typename... Args>
+void bufferprintf(MessageBuffer& buffer, const char* format, const Args&... args);
 
 /**
  * This function takes a format string and any number of arguments of different types.
@@ -75,10 +86,13 @@ void streamprintf(std::ostream& stream, const char* format, const T& value, Args
  * Note: To end a format specifier, you have to add a semicolon.
  * `%%` will escape a % character.
  *
+ * Each format string is parsed only once per thread and cached by its address
+ * (see CompiledFormat), so it should usually be a string literal.
+ *
  * \see http://www.cplusplus.com/reference/ios/ios_base/fmtflags/
  */
 template <typename... Args>
-std::string formatString(const char* format, Args... args);
+std::string formatString(const char* format, const Args&... args);
 
 } // namespace loggingzeug
 
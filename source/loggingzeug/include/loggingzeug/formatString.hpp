@@ -2,41 +2,53 @@
 
 #include <loggingzeug/formatString.h>
 
-#include <sstream>
 #include <cassert>
 
+#include <loggingzeug/CompiledFormat.h>
+
 namespace loggingzeug
 {
 
 template <typename T, typename... Args>
-void streamprintf(std::ostream& stream, const char* format, const T& value, Args... args)
+void streamprintf(std::ostream& stream, const char* format, const T& value, const Args&... args)
+{
+    assert(format != nullptr);
+
+    MessageBuffer buffer;
+    buffer.setFlags(stream.flags());
+    buffer.setPrecision(stream.precision());
+    buffer.setWidth(stream.width());
+    buffer.setFill(stream.fill());
+
+    bufferprintf(buffer, format, value, args...);
+
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    stream.flags(buffer.flags());
+    stream.precision(buffer.precision());
+    stream.width(buffer.width());
+    stream.fill(buffer.fill());
+}
+
+template <typename... Args>
+void bufferprintf(MessageBuffer& buffer, const char* format, const Args&... args)
 {
     assert(format != nullptr);
 
-	while (*format)
-	{
-		if (*format == '%' && *++format != '%')
-		{
-			auto flags = stream.flags();
-			parseFormat(stream, format);
-			stream << value;
-			stream.flags(flags);
-			streamprintf(stream, format, args...);
-			return;
-		}
-		else
-			stream << *format++;
-	}
+    // Formats beyond the capacity of the cache are compiled for each call
+    if (const auto compiled = CompiledFormat::cached(format))
+        compiled->write(buffer, args...);
+    else
+        CompiledFormat(format).write(buffer, args...);
 }
 
 template <typename... Args>
-std::string formatString(const char* format, Args... args)
+std::string formatString(const char* format, const Args&... args)
 {
     assert(format != nullptr);
 
-	std::stringstream ss;
-	streamprintf(ss, format, args...);
-	return ss.str();
+    MessageBuffer buffer;
+    bufferprintf(buffer, format, args...);
+    return buffer.str();
 }
 
 } // namespace loggingzeug
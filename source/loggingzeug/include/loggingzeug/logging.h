@@ -2,8 +2,11 @@
 
 #include <loggingzeug/loggingzeug_api.h>
 
+#include <loggingzeug/LogContext.h>
 #include <loggingzeug/LogMessage.h>
 #include <loggingzeug/LogMessageBuilder.h>
+#include <loggingzeug/LogSinks.h>
+#include <loggingzeug/RateLimiter.h>
 
 namespace loggingzeug
 {
@@ -13,7 +16,7 @@ class LogMessageBuilder;
 
 /**
   * Creates a stream like object (LogMessageBuilder) to create a LogMessage from the objects
-  * passed to it and sends the LogMessage to the global LogMessageHandler when the builder goes out of scope.
+  * passed to it and sends the LogMessage to the logging handlers when the builder goes out of scope.
   * Similar to `qDebug()` from Qt.
   *
   * \code{.cpp}
@@ -26,12 +29,72 @@ LOGGINGZEUG_API LogMessageBuilder warning(const std::string & context = "");
 LOGGINGZEUG_API LogMessageBuilder critical(const std::string & context = "");
 LOGGINGZEUG_API LogMessageBuilder fatal(const std::string & context = "");
 
+/**
+ * Same as above for interned contexts, which avoids looking up the context by its name.
+ *
+ * \see LogContext
+ */
+LOGGINGZEUG_API LogMessageBuilder info(const LogContext & context, LogMessage::Level level = LogMessage::Info);
+LOGGINGZEUG_API LogMessageBuilder debug(const LogContext & context);
+LOGGINGZEUG_API LogMessageBuilder warning(const LogContext & context);
+LOGGINGZEUG_API LogMessageBuilder critical(const LogContext & context);
+LOGGINGZEUG_API LogMessageBuilder fatal(const LogContext & context);
+
+/**
+ * Replaces all logging handlers by the given one, which receives all messages, and deletes
+ * the previous ones. Passing nullptr discards all messages. Takes ownership of the handler.
+ */
 LOGGINGZEUG_API void setLoggingHandler(AbstractLogHandler * handler);
+
+/**
+ * Returns the first of the logging handlers, or nullptr if there is none.
+ */
 LOGGINGZEUG_API AbstractLogHandler * loggingHandler();
 
+/**
+ * Adds a logging handler that receives the messages up to the given verbosity level, in
+ * addition to the other handlers, or changes the verbosity level of a handler that was added
+ * before. Takes ownership of the handler. Each message is formatted once for all handlers.
+ *
+ * \code{.cpp}
+ * setLoggingHandler(nullptr);
+ * addLoggingHandler(new ConsoleLogHandler, LogMessage::Warning);
+ * addLoggingHandler(new AsyncLogHandler("service.log"), LogMessage::Debug);
+ * setVerbosityLevel(LogMessage::Debug);
+ * \endcode
+ *
+ * Handlers can be added and removed while other threads are logging, but not from within
+ * a handler or while the same thread builds a message.
+ *
+ * \see LogSinks
+ */
+LOGGINGZEUG_API void addLoggingHandler(AbstractLogHandler * handler, LogMessage::Level verbosity = LogMessage::Info);
+
+/**
+ * Removes and deletes a logging handler, once no message is dispatched to it anymore.
+ */
+LOGGINGZEUG_API void removeLoggingHandler(AbstractLogHandler * handler);
+
 LOGGINGZEUG_API void setVerbosityLevel(LogMessage::Level verbosity);
 LOGGINGZEUG_API LogMessage::Level verbosityLevel();
 
+/**
+ * Sets the verbosity level of a single context, e.g., to debug one subsystem
+ * or to silence another. It takes precedence over the global verbosity level.
+ *
+ * \see LogContext::setVerbosityLevel
+ */
+LOGGINGZEUG_API void setVerbosityLevel(const std::string & context, LogMessage::Level verbosity);
+
+/**
+ * Checks if messages of the given level may be handled, i.e., if the level is within the
+ * verbosity level of any context and of any logging handler. This is a single inline
+ * comparison, used by the logging macros to skip disabled statements entirely.
+ *
+ * \see LOGGINGZEUG_INFO
+ */
+inline bool isEnabled(LogMessage::Level level);
+
 /**
  * Uses formatString to write on the usual logging streams.
  *
@@ -44,32 +107,83 @@ LOGGINGZEUG_API LogMessage::Level verbosityLevel();
  *   \see formatString
  */
 template <typename... Arguments>
-void fInfo(const char* format, Arguments... arguments);
+void fInfo(const char* format, const Arguments&... arguments);
 
 /**
  *  \see fInfo
  */
 template <typename... Arguments>
-void fDebug(const char* format, Arguments... arguments);
+void fDebug(const char* format, const Arguments&... arguments);
 
 /**
  *  \see fInfo
  */
 template <typename... Arguments>
-void fWarning(const char* format, Arguments... arguments);
+void fWarning(const char* format, const Arguments&... arguments);
 
 /**
  *  \see fInfo
  */
 template <typename... Arguments>
-void fCritical(const char* format, Arguments... arguments);
+void fCritical(const char* format, const Arguments&... arguments);
 
 /**
  *  \see fInfo
  */
 template <typename... Arguments>
-void fFatal(const char* format, Arguments... arguments);
+void fFatal(const char* format, const Arguments&... arguments);
 
 } // namespace loggingzeug
 
+
+/**
+ * Highest level compiled into the logging macros; statements above it are removed
+ * by the compiler. Define it, e.g., as loggingzeug::LogMessage::Warning to strip
+ * debug and info statements from release builds.
+ */
+#ifndef LOGGINGZEUG_MAXIMUM_LEVEL
+#define LOGGINGZEUG_MAXIMUM_LEVEL loggingzeug::LogMessage::Info
+#endif
+
+/**
+ * Like info(), debug() etc., but if the level is disabled, neither the arguments of the
+ * macro nor any of the objects streamed into the message are evaluated, and no
+ * LogMessageBuilder is created. A disabled statement costs a single branch.
+ *
+ * \code{.cpp}
+ * LOGGINGZEUG_DEBUG("renderer") << "Frame " << frame << " took " << expensiveStatistics();
+ * \endcode
+ *
+ * The macros are single statements and can be used unbraced in if/else.
+ */
+#define LOGGINGZEUG_IF_ENABLED(LEVEL) \
+    if ((LEVEL) > LOGGINGZEUG_MAXIMUM_LEVEL || !loggingzeug::isEnabled(LEVEL)) {} else
+
+#define LOGGINGZEUG_INFO(...) LOGGINGZEUG_IF_ENABLED(loggingzeug::LogMessage::Info) loggingzeug::info(__VA_ARGS__)
+#define LOGGINGZEUG_DEBUG(...) LOGGINGZEUG_IF_ENABLED(loggingzeug::LogMessage::Debug) loggingzeug::debug(__VA_ARGS__)
+#define LOGGINGZEUG_WARNING(...) LOGGINGZEUG_IF_ENABLED(loggingzeug::LogMessage::Warning) loggingzeug::warning(__VA_ARGS__)
+#define LOGGINGZEUG_CRITICAL(...) LOGGINGZEUG_IF_ENABLED(loggingzeug::LogMessage::Critical) loggingzeug::critical(__VA_ARGS__)
+#define LOGGINGZEUG_FATAL(...) LOGGINGZEUG_IF_ENABLED(loggingzeug::LogMessage::Fatal) loggingzeug::fatal(__VA_ARGS__)
+
+/**
+ * Discards the following statement if messages of the given level are disabled, or if
+ * it is executed more often than the given rate, after an initial burst. Each call site
+ * has its own RateLimiter. The level is checked first, so disabled statements neither
+ * spend a token nor count as suppressed. This keeps a flood of messages from one place
+ * from saturating the logging handler:
+ *
+ * \code{.cpp}
+ * LOGGINGZEUG_RATE_LIMITED(loggingzeug::LogMessage::Warning, 10, 100) loggingzeug::warning("network") << "Dropped packet from " << address;
+ * \endcode
+ *
+ * \see RateLimiter
+ * \see LOGGINGZEUG_IF_ENABLED
+ */
+#define LOGGINGZEUG_RATE_LIMITED(LEVEL, MESSAGES_PER_SECOND, BURST) \
+    LOGGINGZEUG_IF_ENABLED(LEVEL) \
+    if (!([] () -> loggingzeug::RateLimiter & { \
+            static loggingzeug::RateLimiter limiter(MESSAGES_PER_SECOND, BURST); \
+            return limiter; \
+        }().acquire())) {} else
+
 #include <loggingzeug/logging.hpp>
@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <atomic>
 #include <cassert>
 
 #include <loggingzeug/formatString.h>
@@ -9,39 +10,70 @@
 namespace loggingzeug
 {
 
-template <typename... Arguments> void fInfo(const char* format, Arguments... arguments)
+namespace detail
+{
+
+// Highest level that is handled in any context and by any logging handler; below Fatal if there is none
+LOGGINGZEUG_API extern std::atomic<int> enabledLevel;
+
+// Updates enabledLevel after the handlers or a verbosity level changed
+LOGGINGZEUG_API void updateEnabledLevel();
+
+} // namespace detail
+
+inline bool isEnabled(LogMessage::Level level)
+{
+    return static_cast<int>(level) <= detail::enabledLevel.load(std::memory_order_relaxed);
+}
+
+template <typename... Arguments> void fInfo(const char* format, const Arguments&... arguments)
 {
     assert(format != nullptr);
 
-    info() << formatString(format, arguments...);
+    if (!isEnabled(LogMessage::Info))
+        return;
+
+    info().format(format, arguments...);
 }
 
-template <typename... Arguments> void fDebug(const char* format, Arguments... arguments)
+template <typename... Arguments> void fDebug(const char* format, const Arguments&... arguments)
 {
     assert(format != nullptr);
 
-    debug() << formatString(format, arguments...);
+    if (!isEnabled(LogMessage::Debug))
+        return;
+
+    debug().format(format, arguments...);
 }
 
-template <typename... Arguments> void fWarning(const char* format, Arguments... arguments)
+template <typename... Arguments> void fWarning(const char* format, const Arguments&... arguments)
 {
     assert(format != nullptr);
 
-    warning() << formatString(format, arguments...);
+    if (!isEnabled(LogMessage::Warning))
+        return;
+
+    warning().format(format, arguments...);
 }
 
-template <typename... Arguments> void fCritical(const char* format, Arguments... arguments)
+template <typename... Arguments> void fCritical(const char* format, const Arguments&... arguments)
 {
     assert(format != nullptr);
 
-    critical() << formatString(format, arguments...);
+    if (!isEnabled(LogMessage::Critical))
+        return;
+
+    critical().format(format, arguments...);
 }
 
-template <typename... Arguments> void fFatal(const char* format, Arguments... arguments)
+template <typename... Arguments> void fFatal(const char* format, const Arguments&... arguments)
 {
     assert(format != nullptr);
 
-    fatal() << formatString(format, arguments...);
+    if (!isEnabled(LogMessage::Fatal))
+        return;
+
+    fatal().format(format, arguments...);
 }
 
 } // namespace loggingzeug
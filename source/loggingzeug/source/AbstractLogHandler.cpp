@@ -0,0 +1,19 @@
+#include <loggingzeug/AbstractLogHandler.h>
+
+#include <loggingzeug/LogMessage.h>
+#include <loggingzeug/LogRecord.h>
+
+namespace loggingzeug
+{
+
+void AbstractLogHandler::handleRecord(const LogRecord & record)
+{
+    handle(LogMessage(record.level(), record.message(), record.context()));
+}
+
+bool AbstractLogHandler::handlesRecords() const
+{
+    return false;
+}
+
+} // namespace loggingzeug
@@ -0,0 +1,347 @@
+#include <loggingzeug/AsyncLogHandler.h>
+
+#include <cstddef>
+#include <chrono>
+
+namespace
+{
+
+// Number of messages the writer takes from the queue before writing them to the file
+const size_t maximumBatchSize = 256;
+
+// Bytes buffered by the file in addition to the batches
+const size_t fileBufferSize = 1 << 16;
+
+size_t nextPowerOfTwo(size_t value)
+{
+    size_t result = 2;
+
+    while (result < value)
+        result <<= 1;
+
+    return result;
+}
+
+} // namespace
+
+namespace loggingzeug
+{
+
+AsyncLogHandler::AsyncLogHandler(const std::string & logfile, size_t capacity, OverflowPolicy policy)
+: FileLogHandler(logfile)
+, m_policy(policy)
+, m_mask(nextPowerOfTwo(capacity) - 1)
+, m_slots(new Slot[m_mask + 1])
+, m_tail(0)
+, m_head(0)
+, m_dropped(0)
+, m_file(std::fopen(logfile.c_str(), "a"))
+, m_writerWaiting(false)
+, m_blocked(0)
+, m_flushRequests(0)
+, m_written(0)
+, m_stop(false)
+{
+    for (size_t i = 0; i <= m_mask; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    if (m_file)
+        std::setvbuf(m_file, nullptr, _IOFBF, fileBufferSize);
+
+    m_writer = std::thread(&AsyncLogHandler::run, this);
+}
+
+AsyncLogHandler::~AsyncLogHandler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wakeUp.notify_one();
+    m_writer.join();
+
+    if (m_file)
+        std::fclose(m_file);
+}
+
+void AsyncLogHandler::handle(const LogMessage & message)
+{
+    // Fatal messages are never dropped
+    const OverflowPolicy policy = message.level() == LogMessage::Fatal ? OverflowPolicy::Block : m_policy;
+
+    while (!push(message))
+    {
+        if (policy == OverflowPolicy::Drop)
+        {
+            ++m_dropped;
+            return;
+        }
+
+        if (policy == OverflowPolicy::DropOldest)
+        {
+            if (dropOldest())
+                ++m_dropped;
+
+            continue;
+        }
+
+        waitForRoom();
+    }
+
+    if (message.level() == LogMessage::Fatal)
+        flush();
+    else
+        wakeWriter();
+}
+
+void AsyncLogHandler::flush()
+{
+    const size_t target = m_tail.load();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    ++m_flushRequests;
+    m_wakeUp.notify_one();
+
+    m_flushed.wait(lock, [this, target] () { return m_written >= target; });
+
+    --m_flushRequests;
+}
+
+AsyncLogHandler::OverflowPolicy AsyncLogHandler::overflowPolicy() const
+{
+    return m_policy;
+}
+
+size_t AsyncLogHandler::capacity() const
+{
+    return m_mask + 1;
+}
+
+size_t AsyncLogHandler::droppedMessages() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+bool AsyncLogHandler::push(const LogMessage & message)
+{
+    size_t position = m_tail.load(std::memory_order_relaxed);
+    Slot * slot;
+
+    while (true)
+    {
+        slot = &m_slots[position & m_mask];
+
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            return false; // full
+        }
+        else
+        {
+            position = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Assigning keeps the capacity of the slot's strings, so that steady state logging does not allocate here
+    slot->level = message.level();
+    slot->message.assign(message.message());
+    slot->context.assign(message.context());
+
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool AsyncLogHandler::pop(std::string & batch)
+{
+    size_t position = m_head.load(std::memory_order_relaxed);
+    Slot * slot;
+
+    while (true)
+    {
+        slot = &m_slots[position & m_mask];
+
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            // Logging threads dropping the oldest message compete for the head
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            return false; // empty, or the next message is still being copied
+        }
+        else
+        {
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    batch += messagePrefix(slot->level, slot->context);
+    batch += slot->message;
+    batch += '\n';
+
+    slot->sequence.store(position + m_mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool AsyncLogHandler::dropOldest()
+{
+    size_t position = m_head.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Slot & slot = m_slots[position & m_mask];
+
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.sequence.store(position + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false; // someone else made room in the meantime
+        }
+        else
+        {
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogHandler::isFull() const
+{
+    const size_t position = m_tail.load();
+    const size_t sequence = m_slots[position & m_mask].sequence.load(std::memory_order_acquire);
+
+    return static_cast<std::ptrdiff_t>(sequence - position) < 0;
+}
+
+void AsyncLogHandler::waitForRoom()
+{
+    ++m_blocked;
+
+    // Pairs with the fence in wakeBlocked(): either the writer sees us blocked or we see the room it made
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_wakeUp.notify_one();
+        m_room.wait(lock, [this] () { return !isFull(); });
+    }
+
+    --m_blocked;
+}
+
+void AsyncLogHandler::wakeBlocked()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_blocked.load(std::memory_order_relaxed) == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_room.notify_all();
+}
+
+void AsyncLogHandler::wakeWriter()
+{
+    // Pairs with the fence in run(): either the writer sees the new message or we see it waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!m_writerWaiting.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeUp.notify_one();
+}
+
+void AsyncLogHandler::run()
+{
+    std::string batch;
+    batch.reserve(maximumBatchSize * 128);
+
+    while (true)
+    {
+        size_t count = 0;
+        bool drained = false;
+
+        batch.clear();
+
+        while (count < maximumBatchSize)
+        {
+            if (!pop(batch))
+            {
+                drained = true;
+                break;
+            }
+
+            ++count;
+        }
+
+        // The taken slots can be reused while the batch is written
+        if (count > 0)
+            wakeBlocked();
+
+        if (m_file && !batch.empty())
+            std::fwrite(batch.data(), 1, batch.size(), m_file);
+
+        if (!drained && m_flushRequests.load() == 0)
+            continue;
+
+        if (m_file)
+            std::fflush(m_file);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Messages taken by logging threads dropping the oldest message count as written
+        m_written = m_head.load();
+        m_flushed.notify_all();
+
+        if (!drained)
+            continue;
+
+        if (m_stop)
+        {
+            // Wait for logging threads that are still copying their message
+            if (m_head.load() == m_tail.load())
+                break;
+
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+
+        m_writerWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Check again for messages published before the logging threads could see the writer waiting
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_slots[head & m_mask].sequence.load(std::memory_order_acquire) != head + 1)
+            m_wakeUp.wait_for(lock, std::chrono::milliseconds(100));
+
+        m_writerWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace loggingzeug
@@ -0,0 +1,189 @@
+
+#include <loggingzeug/BinaryLogHandler.h>
+
+#include <cstring>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <loggingzeug/BinaryLogReader.h>
+#include <loggingzeug/LogRecord.h>
+
+#include "binaryEncoding.h"
+
+
+namespace
+{
+
+// Scans an existing binary log for the end of its last complete entry, or returns 0 if there is no valid header
+size_t completeSize(const std::string & logfile)
+{
+    loggingzeug::BinaryLogReader reader(logfile);
+    auto record = loggingzeug::LogRecord(loggingzeug::LogMessage::Info, nullptr, std::string(), std::string());
+
+    while (reader.read(record))
+    {
+    }
+
+    return reader.position();
+}
+
+bool truncateFile(std::FILE * file, size_t size)
+{
+#ifdef WIN32
+    return _chsize(_fileno(file), static_cast<long>(size)) == 0;
+#else
+    return ftruncate(fileno(file), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+} // namespace
+
+
+namespace loggingzeug
+{
+
+BinaryLogHandler::BinaryLogHandler(const std::string & logfile)
+: m_file(nullptr)
+{
+    const auto complete = completeSize(logfile);
+
+    m_file = std::fopen(logfile.c_str(), "ab");
+
+    if (!m_file)
+        return;
+
+    std::setvbuf(m_file, nullptr, _IOFBF, 1 << 16);
+
+    std::fseek(m_file, 0, SEEK_END);
+    const auto size = static_cast<size_t>(std::ftell(m_file));
+
+    // A file that is not a compatible binary log is left untouched
+    const auto headerSize = sizeof(binaryLogMagic) + 2;
+    const auto compatible = complete > 0 || size < headerSize;
+
+    // An entry cut off, e.g., by a crash of the writing process is removed,
+    // as the reader would take the appended entries for its remainder
+    if (!compatible || (size > complete && !truncateFile(m_file, complete)))
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return;
+    }
+
+    // Appended sessions start over with their format and context ids
+    if (complete > 0)
+    {
+        m_entry.assign(1, static_cast<char>(BinaryLogEntry::Session));
+    }
+    else
+    {
+        m_entry.assign(binaryLogMagic, sizeof(binaryLogMagic));
+        m_entry += static_cast<char>(binaryLogVersion);
+        m_entry += static_cast<char>(sizeof(long double));
+    }
+
+    std::fwrite(m_entry.data(), 1, m_entry.size(), m_file);
+}
+
+BinaryLogHandler::~BinaryLogHandler()
+{
+    if (m_file)
+        std::fclose(m_file);
+}
+
+void BinaryLogHandler::handle(const LogMessage & message)
+{
+    write(message.level(), message.context(), nullptr, message.message());
+}
+
+void BinaryLogHandler::handleRecord(const LogRecord & record)
+{
+    write(record.level(), record.context(), record.format(), record.arguments());
+}
+
+bool BinaryLogHandler::handlesRecords() const
+{
+    return true;
+}
+
+void BinaryLogHandler::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_file)
+        std::fflush(m_file);
+}
+
+void BinaryLogHandler::write(LogMessage::Level level, const std::string & context, const char * format, const std::string & data)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_file)
+        return;
+
+    const auto contextIndex = contextId(context);
+    const auto formatIndex = format ? formatId(format) : 0;
+
+    m_entry.clear();
+    m_entry += static_cast<char>(BinaryLogEntry::Record);
+    m_entry += static_cast<char>(level);
+    appendVarint(m_entry, contextIndex);
+    appendVarint(m_entry, formatIndex);
+    appendVarint(m_entry, data.size());
+
+    std::fwrite(m_entry.data(), 1, m_entry.size(), m_file);
+    std::fwrite(data.data(), 1, data.size(), m_file);
+
+    if (level <= LogMessage::Critical)
+        std::fflush(m_file);
+}
+
+size_t BinaryLogHandler::formatId(const char * format)
+{
+    const auto it = m_formatIds.find(format);
+
+    // The address of a format string may be reused for a different one
+    if (it != m_formatIds.end() && m_formats[it->second - 1] == format)
+        return it->second;
+
+    m_formats.push_back(format);
+    const auto id = m_formats.size();
+    m_formatIds[format] = id;
+
+    m_entry.clear();
+    m_entry += static_cast<char>(BinaryLogEntry::Format);
+    appendVarint(m_entry, id);
+    appendVarint(m_entry, m_formats.back().size());
+    m_entry += m_formats.back();
+
+    std::fwrite(m_entry.data(), 1, m_entry.size(), m_file);
+
+    return id;
+}
+
+size_t BinaryLogHandler::contextId(const std::string & context)
+{
+    const auto it = m_contextIds.find(context);
+
+    if (it != m_contextIds.end())
+        return it->second;
+
+    const auto id = m_contextIds.size();
+    m_contextIds[context] = id;
+
+    m_entry.clear();
+    m_entry += static_cast<char>(BinaryLogEntry::Context);
+    appendVarint(m_entry, id);
+    appendVarint(m_entry, context.size());
+    m_entry += context;
+
+    std::fwrite(m_entry.data(), 1, m_entry.size(), m_file);
+
+    return id;
+}
+
+} // namespace loggingzeug
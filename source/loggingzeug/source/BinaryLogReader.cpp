@@ -0,0 +1,166 @@
+
+#include <loggingzeug/BinaryLogReader.h>
+
+#include <cstring>
+
+#include "binaryEncoding.h"
+
+
+namespace loggingzeug
+{
+
+BinaryLogReader::BinaryLogReader(const std::string & logfile)
+: m_file(std::fopen(logfile.c_str(), "rb"))
+, m_valid(false)
+, m_offset(0)
+, m_position(0)
+, m_formatBase(0)
+, m_contextBase(0)
+{
+    if (!m_file)
+        return;
+
+    char header[sizeof(binaryLogMagic) + 2];
+
+    m_valid = std::fread(header, 1, sizeof(header), m_file) == sizeof(header)
+        && std::memcmp(header, binaryLogMagic, sizeof(binaryLogMagic)) == 0
+        && static_cast<unsigned char>(header[sizeof(binaryLogMagic)]) == binaryLogVersion
+        && static_cast<unsigned char>(header[sizeof(binaryLogMagic) + 1]) == sizeof(long double);
+
+    if (m_valid)
+        m_offset = m_position = sizeof(header);
+}
+
+BinaryLogReader::~BinaryLogReader()
+{
+    if (m_file)
+        std::fclose(m_file);
+}
+
+bool BinaryLogReader::isValid() const
+{
+    return m_valid;
+}
+
+size_t BinaryLogReader::position() const
+{
+    return m_position;
+}
+
+bool BinaryLogReader::read(LogRecord & record)
+{
+    if (!m_valid)
+        return false;
+
+    unsigned long long id;
+
+    for (;;)
+    {
+        const auto entry = readByte();
+
+        switch (entry)
+        {
+        case static_cast<int>(BinaryLogEntry::Format):
+            if (!readVarint(id) || id != m_formats.size() - m_formatBase + 1)
+                return m_valid = false;
+            m_formats.emplace_back();
+            if (!readString(m_formats.back()))
+                return m_valid = false;
+            m_position = m_offset;
+            break;
+
+        case static_cast<int>(BinaryLogEntry::Context):
+            if (!readVarint(id) || id != m_contexts.size() - m_contextBase)
+                return m_valid = false;
+            m_contexts.emplace_back();
+            if (!readString(m_contexts.back()))
+                return m_valid = false;
+            m_position = m_offset;
+            break;
+
+        case static_cast<int>(BinaryLogEntry::Record):
+            {
+                const auto level = readByte();
+                unsigned long long context;
+                unsigned long long format;
+
+                if (level < LogMessage::Fatal || level > LogMessage::Info
+                    || !readVarint(context) || context >= m_contexts.size() - m_contextBase
+                    || !readVarint(format) || format > m_formats.size() - m_formatBase
+                    || !readString(m_data))
+                    return m_valid = false;
+
+                record = LogRecord(static_cast<LogMessage::Level>(level),
+                    format == 0 ? nullptr : m_formats[m_formatBase + format - 1].c_str(),
+                    m_contexts[m_contextBase + context], m_data);
+            }
+            m_position = m_offset;
+            return true;
+
+        case static_cast<int>(BinaryLogEntry::Session):
+            // Earlier format strings are kept, as records returned before refer to them
+            m_formatBase = m_formats.size();
+            m_contextBase = m_contexts.size();
+            m_position = m_offset;
+            break;
+
+        case EOF:
+            // The file ends behind a complete entry
+            return false;
+
+        default:
+            return m_valid = false;
+        }
+    }
+}
+
+bool BinaryLogReader::readVarint(unsigned long long & value)
+{
+    value = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        const auto byte = readByte();
+
+        if (byte == EOF)
+            return false;
+
+        value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool BinaryLogReader::readString(std::string & string)
+{
+    unsigned long long size;
+
+    // Sizes beyond any message written by the handler indicate a corrupt file
+    if (!readVarint(size) || size > (1ull << 31))
+        return false;
+
+    string.resize(static_cast<size_t>(size));
+
+    if (size == 0)
+        return true;
+
+    const auto read = std::fread(&string[0], 1, string.size(), m_file);
+    m_offset += read;
+
+    return read == string.size();
+}
+
+int BinaryLogReader::readByte()
+{
+    const auto byte = std::fgetc(m_file);
+
+    if (byte != EOF)
+        ++m_offset;
+
+    return byte;
+}
+
+} // namespace loggingzeug
@@ -0,0 +1,374 @@
+
+#include <loggingzeug/CompiledFormat.h>
+
+#include <cassert>
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+
+#include <loggingzeug/formatString.h>
+
+
+namespace
+{
+
+// Composes the flags of a sequence of std::ios_base::setf calls
+void setf(std::ios_base::fmtflags & clearedFlags, std::ios_base::fmtflags & setFlags, std::ios_base::fmtflags flags, std::ios_base::fmtflags mask)
+{
+    clearedFlags |= mask;
+    setFlags = (setFlags & ~mask) | (flags & mask);
+}
+
+template <typename T>
+void formatSigned(loggingzeug::MessageBuffer & buffer, T value)
+{
+    const auto negative = value < 0;
+    const auto magnitude = negative ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+
+    buffer.appendInteger(magnitude, negative, true, sizeof(T));
+}
+
+} // namespace
+
+
+namespace loggingzeug
+{
+
+const size_t CompiledFormat::MaximumCacheSize;
+
+CompiledFormat::Specifier::Specifier()
+: clearedFlags()
+, setFlags()
+, hasFill(false)
+, fill(' ')
+, width(0)
+, precision(0)
+, end(0)
+{
+}
+
+CompiledFormat::Specifier CompiledFormat::Specifier::parse(const char *& format)
+{
+    Specifier specifier;
+
+    auto & cleared = specifier.clearedFlags;
+    auto & set = specifier.setFlags;
+
+    for (;; ++format)
+    {
+        if (*format == 'l')
+            setf(cleared, set, std::ios_base::left, std::ios_base::adjustfield);
+        else if (*format == 'r')
+            setf(cleared, set, std::ios_base::right, std::ios_base::adjustfield);
+        else if (*format == 'i')
+            setf(cleared, set, std::ios_base::internal, std::ios_base::adjustfield);
+        else
+            break;
+    }
+
+    // Uppercase independent flags are accepted, but have no effect
+    for (;; ++format)
+    {
+        const auto flag = *format;
+
+        if (flag == 'a')
+            setf(cleared, set, std::ios_base::boolalpha, std::ios_base::boolalpha);
+        else if (flag == '+')
+            setf(cleared, set, std::ios_base::showpos, std::ios_base::showpos);
+        else if (flag == ' ')
+            setf(cleared, set, std::ios_base::skipws, std::ios_base::skipws);
+        else if (flag == '#')
+            setf(cleared, set, std::ios_base::showbase, std::ios_base::showbase);
+        else if (flag == 'u')
+            setf(cleared, set, std::ios_base::uppercase, std::ios_base::uppercase);
+        else if (flag == 'p')
+            setf(cleared, set, std::ios_base::showpoint, std::ios_base::showpoint);
+        else if (flag == '0')
+        {
+            specifier.hasFill = true;
+            specifier.fill = '0';
+        }
+        else if (flag != 'A' && flag != 'U' && flag != 'P')
+            break;
+    }
+
+    if (std::tolower(*format) == 'f' || std::tolower(*format) == 'e')
+    {
+        const auto flag = *format++;
+
+        if (std::isupper(flag))
+            setf(cleared, set, std::ios_base::uppercase, std::ios_base::uppercase);
+
+        if (std::tolower(flag) == 'f')
+            setf(cleared, set, std::ios_base::fixed, std::ios_base::floatfield);
+        else
+            setf(cleared, set, std::ios_base::scientific, std::ios_base::floatfield);
+    }
+
+    if (*format == '?' && format[1] != '\0')
+    {
+        specifier.hasFill = true;
+        specifier.fill = format[1];
+        format += 2;
+    }
+
+    format += readInt(format, specifier.width);
+
+    if (*format == '.')
+    {
+        ++format;
+        format += readInt(format, specifier.precision);
+    }
+
+    // Only lowercase base flags are recognized
+    if (*format == 'd')
+        setf(cleared, set, std::ios_base::dec, std::ios_base::basefield);
+    else if (*format == 'o')
+        setf(cleared, set, std::ios_base::oct, std::ios_base::basefield);
+    else if (*format == 'x')
+        setf(cleared, set, std::ios_base::hex, std::ios_base::basefield);
+
+    while (*format && *format++ != ';');
+
+    return specifier;
+}
+
+void CompiledFormat::Specifier::apply(std::ostream & stream) const
+{
+    stream.flags((stream.flags() & ~clearedFlags) | setFlags);
+
+    if (hasFill)
+        stream.fill(fill);
+    if (width > 0)
+        stream.width(width);
+    if (precision > 0)
+        stream.precision(precision);
+}
+
+void CompiledFormat::Specifier::apply(MessageBuffer & buffer) const
+{
+    buffer.setFlags((buffer.flags() & ~clearedFlags) | setFlags);
+
+    if (hasFill)
+        buffer.setFill(fill);
+    if (width > 0)
+        buffer.setWidth(width);
+    if (precision > 0)
+        buffer.setPrecision(precision);
+}
+
+CompiledFormat::CompiledFormat(const char * format)
+: m_format(format)
+{
+    assert(format != nullptr);
+
+    const auto begin = format;
+    std::string text;
+
+    while (*format)
+    {
+        if (*format == '%' && *++format != '%')
+        {
+            auto specifier = Specifier::parse(format);
+
+            specifier.text.swap(text);
+            specifier.end = static_cast<size_t>(format - begin);
+
+            m_specifiers.push_back(std::move(specifier));
+        }
+        else
+        {
+            text += *format++;
+        }
+    }
+
+    m_text.swap(text);
+}
+
+const CompiledFormat * CompiledFormat::cached(const char * format)
+{
+    assert(format != nullptr);
+
+    // Entries are never removed while the thread lives, so that nested formatting keeps them valid
+    static thread_local std::unordered_map<const char *, std::unique_ptr<CompiledFormat>> cache;
+
+    const auto it = cache.find(format);
+
+    if (it != cache.end())
+    {
+        if (it->second->m_format != format)
+            it->second.reset(new CompiledFormat(format));
+
+        return it->second.get();
+    }
+
+    if (cache.size() >= MaximumCacheSize)
+        return nullptr;
+
+    auto & compiled = cache[format];
+    compiled.reset(new CompiledFormat(format));
+
+    return compiled.get();
+}
+
+const std::string & CompiledFormat::format() const
+{
+    return m_format;
+}
+
+const std::vector<CompiledFormat::Specifier> & CompiledFormat::specifiers() const
+{
+    return m_specifiers;
+}
+
+bool CompiledFormat::beginArgument(MessageBuffer & buffer, size_t index, std::ios_base::fmtflags & flags) const
+{
+    // Surplus arguments are ignored
+    if (index >= m_specifiers.size())
+    {
+        writeText(buffer, m_text);
+        return false;
+    }
+
+    const auto & specifier = m_specifiers[index];
+    flags = buffer.flags();
+
+    writeText(buffer, specifier.text);
+    specifier.apply(buffer);
+
+    return true;
+}
+
+void CompiledFormat::endArguments(MessageBuffer & buffer, size_t count) const
+{
+    assert(count <= m_specifiers.size());
+
+    // Without further arguments, the rest of the format string is written as is
+    const auto offset = count == 0 ? 0 : m_specifiers[count - 1].end;
+
+    buffer.appendText(m_format.data() + offset, m_format.size() - offset);
+}
+
+void CompiledFormat::writeArguments(MessageBuffer & buffer, size_t index) const
+{
+    endArguments(buffer, index);
+}
+
+void CompiledFormat::writeText(MessageBuffer & buffer, const std::string & text)
+{
+    if (text.empty())
+        return;
+
+    if (buffer.width() == 0)
+    {
+        buffer.append(text.data(), text.size());
+        return;
+    }
+
+    buffer.appendCharacter(text[0]);
+    buffer.append(text.data() + 1, text.size() - 1);
+}
+
+namespace detail
+{
+
+void formatValue(MessageBuffer & buffer, bool value)
+{
+    if (buffer.flags() & std::ios_base::boolalpha)
+        buffer.appendText(value ? "true" : "false", value ? 4 : 5);
+    else
+        formatSigned(buffer, static_cast<long>(value));
+}
+
+void formatValue(MessageBuffer & buffer, char value)
+{
+    buffer.appendCharacter(value);
+}
+
+void formatValue(MessageBuffer & buffer, signed char value)
+{
+    buffer.appendCharacter(static_cast<char>(value));
+}
+
+void formatValue(MessageBuffer & buffer, unsigned char value)
+{
+    buffer.appendCharacter(static_cast<char>(value));
+}
+
+void formatValue(MessageBuffer & buffer, short value)
+{
+    formatSigned(buffer, value);
+}
+
+void formatValue(MessageBuffer & buffer, unsigned short value)
+{
+    buffer.appendInteger(value, false, false, sizeof(value));
+}
+
+void formatValue(MessageBuffer & buffer, int value)
+{
+    formatSigned(buffer, value);
+}
+
+void formatValue(MessageBuffer & buffer, unsigned int value)
+{
+    buffer.appendInteger(value, false, false, sizeof(value));
+}
+
+void formatValue(MessageBuffer & buffer, long value)
+{
+    formatSigned(buffer, value);
+}
+
+void formatValue(MessageBuffer & buffer, unsigned long value)
+{
+    buffer.appendInteger(value, false, false, sizeof(value));
+}
+
+void formatValue(MessageBuffer & buffer, long long value)
+{
+    formatSigned(buffer, value);
+}
+
+void formatValue(MessageBuffer & buffer, unsigned long long value)
+{
+    buffer.appendInteger(value, false, false, sizeof(value));
+}
+
+void formatValue(MessageBuffer & buffer, float value)
+{
+    buffer.appendFloat(value, false);
+}
+
+void formatValue(MessageBuffer & buffer, double value)
+{
+    buffer.appendFloat(value, false);
+}
+
+void formatValue(MessageBuffer & buffer, long double value)
+{
+    buffer.appendFloat(value, true);
+}
+
+void formatValue(MessageBuffer & buffer, char * value)
+{
+    formatValue(buffer, static_cast<const char *>(value));
+}
+
+void formatValue(MessageBuffer & buffer, const char * value)
+{
+    // A std::ostream writes nothing for null strings
+    if (value)
+        buffer.appendText(value, std::strlen(value));
+}
+
+void formatValue(MessageBuffer & buffer, const std::string & value)
+{
+    buffer.appendText(value.data(), value.size());
+}
+
+} // namespace detail
+
+} // namespace loggingzeug
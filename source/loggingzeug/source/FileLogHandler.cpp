@@ -19,15 +19,20 @@ void FileLogHandler::handle(const LogMessage & message)
 
 std::string FileLogHandler::messagePrefix(const LogMessage & message)
 {
-	std::string prefix = levelString(message.level());
+	return messagePrefix(message.level(), message.context());
+}
+
+std::string FileLogHandler::messagePrefix(LogMessage::Level level, const std::string & context)
+{
+	std::string prefix = levelString(level);
 
 
-	if (!message.context().empty())
+	if (!context.empty())
 	{
 		if (!prefix.empty())
 			prefix = prefix + " ";
 
-		prefix = prefix + "[" + message.context() + "]";
+		prefix = prefix + "[" + context + "]";
 	}
 
 	if (prefix.empty())
@@ -0,0 +1,198 @@
+#include <loggingzeug/LogContext.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <loggingzeug/logging.h>
+
+namespace
+{
+
+// Level of contexts that follow the global verbosity level
+const int inheritedLevel = -2;
+
+// Contexts are stored in chunks that never move, so that they can be read without locking
+const size_t chunkSize = 256;
+const size_t maximumChunks = 1024;
+
+struct Context
+{
+    Context()
+    : level(inheritedLevel)
+    {
+    }
+
+    std::string name;
+    std::atomic<int> level;
+};
+
+struct Registry
+{
+    Registry()
+    : count(0)
+    , maximumLevel(inheritedLevel)
+    {
+        for (auto & chunk : chunks)
+            chunk.store(nullptr, std::memory_order_relaxed);
+
+        add(std::string());
+    }
+
+    Context & context(size_t id) const
+    {
+        return chunks[id / chunkSize].load(std::memory_order_acquire)[id % chunkSize];
+    }
+
+    // Requires the mutex; further names share the default context once the table is full
+    size_t add(const std::string & name)
+    {
+        if (count == chunkSize * maximumChunks)
+            return 0;
+
+        const auto id = count++;
+
+        auto chunk = chunks[id / chunkSize].load(std::memory_order_relaxed);
+
+        if (!chunk)
+        {
+            chunk = new Context[chunkSize];
+            chunks[id / chunkSize].store(chunk, std::memory_order_release);
+        }
+
+        chunk[id % chunkSize].name = name;
+        ids[name] = id;
+
+        return id;
+    }
+
+    // Requires the mutex
+    void updateMaximumLevel()
+    {
+        auto level = inheritedLevel;
+
+        for (size_t id = 0; id < count; ++id)
+            level = std::max(level, context(id).level.load(std::memory_order_relaxed));
+
+        maximumLevel = level;
+    }
+
+    std::atomic<Context *> chunks[maximumChunks];
+
+    std::mutex mutex;
+    std::unordered_map<std::string, size_t> ids;
+    size_t count;
+    std::atomic<int> maximumLevel;  // of the contexts with their own verbosity level
+};
+
+Registry & registry()
+{
+    // Never destroyed, as messages may be logged during static destruction
+    static const auto registry = new Registry;
+
+    return *registry;
+}
+
+size_t intern(const std::string & name)
+{
+    if (name.empty())
+        return 0;
+
+    // Threads look up the contexts they used before without locking
+    static thread_local std::unordered_map<std::string, size_t> cache;
+
+    const auto it = cache.find(name);
+
+    if (it != cache.end())
+        return it->second;
+
+    auto & contexts = registry();
+    std::lock_guard<std::mutex> lock(contexts.mutex);
+
+    const auto known = contexts.ids.find(name);
+    const auto id = known != contexts.ids.end() ? known->second : contexts.add(name);
+
+    cache[name] = id;
+
+    return id;
+}
+
+} // namespace
+
+namespace loggingzeug
+{
+
+LogContext::LogContext()
+: m_id(0)
+{
+}
+
+LogContext::LogContext(const std::string & name)
+: m_id(intern(name))
+{
+}
+
+size_t LogContext::id() const
+{
+    return m_id;
+}
+
+const std::string & LogContext::name() const
+{
+    return registry().context(m_id).name;
+}
+
+LogMessage::Level LogContext::verbosityLevel() const
+{
+    const auto level = registry().context(m_id).level.load(std::memory_order_relaxed);
+
+    return level == inheritedLevel ? loggingzeug::verbosityLevel() : static_cast<LogMessage::Level>(level);
+}
+
+bool LogContext::hasVerbosityLevel() const
+{
+    return registry().context(m_id).level.load(std::memory_order_relaxed) != inheritedLevel;
+}
+
+void LogContext::setVerbosityLevel(LogMessage::Level verbosity) const
+{
+    auto & contexts = registry();
+
+    {
+        std::lock_guard<std::mutex> lock(contexts.mutex);
+
+        contexts.context(m_id).level = static_cast<int>(verbosity);
+        contexts.updateMaximumLevel();
+    }
+
+    detail::updateEnabledLevel();
+}
+
+void LogContext::resetVerbosityLevel() const
+{
+    auto & contexts = registry();
+
+    {
+        std::lock_guard<std::mutex> lock(contexts.mutex);
+
+        contexts.context(m_id).level = inheritedLevel;
+        contexts.updateMaximumLevel();
+    }
+
+    detail::updateEnabledLevel();
+}
+
+bool LogContext::includes(LogMessage::Level level) const
+{
+    return level <= verbosityLevel();
+}
+
+LogMessage::Level LogContext::maximumVerbosityLevel()
+{
+    const auto level = registry().maximumLevel.load(std::memory_order_relaxed);
+
+    return static_cast<LogMessage::Level>(std::max(level, static_cast<int>(loggingzeug::verbosityLevel())));
+}
+
+} // namespace loggingzeug
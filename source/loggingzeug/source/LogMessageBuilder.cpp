@@ -1,10 +1,12 @@
 
 #include <loggingzeug/LogMessageBuilder.h>
 
+#include <cstdint>
 #include <cstring>
 #include <cassert>
 
 #include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/LogRecord.h>
 
 
 namespace loggingzeug
@@ -12,146 +14,234 @@ namespace loggingzeug
 
 LogMessageBuilder::LogMessageBuilder(LogMessage::Level level, AbstractLogHandler * handler, const std::string & context)
 : m_level(level)
-, m_handler(handler)
+, m_sinks(handler)
+, m_context(handler ? LogContext(context) : LogContext())
+, m_format(nullptr)
+{
+    // handler is nullptr for messages above the verbosity level
+}
+
+LogMessageBuilder::LogMessageBuilder(LogMessage::Level level, AbstractLogHandler * handler, const LogContext & context)
+: m_level(level)
+, m_sinks(handler)
 , m_context(context)
-, m_stream(new std::stringstream)
+, m_format(nullptr)
 {
-    assert(handler != nullptr);
 }
 
-LogMessageBuilder::LogMessageBuilder(const LogMessageBuilder & builder)
+LogMessageBuilder::LogMessageBuilder(LogMessage::Level level, LogSinks && sinks, const LogContext & context)
+: m_level(level)
+, m_sinks(std::move(sinks))
+, m_context(context)
+, m_format(nullptr)
+{
+    // sinks is empty for messages above the verbosity level
+}
+
+LogMessageBuilder::LogMessageBuilder(LogMessageBuilder && builder)
 : m_level(builder.m_level)
-, m_handler(builder.m_handler)
+, m_sinks(std::move(builder.m_sinks))
 , m_context(builder.m_context)
-, m_stream(builder.m_stream)
+, m_buffer(std::move(builder.m_buffer))
+, m_format(builder.m_format)
+, m_arguments(std::move(builder.m_arguments))
 {
+    // The moved-from sinks are empty, so the moved-from builder does not emit the message
 }
 
 LogMessageBuilder::~LogMessageBuilder()
 {
-    if (m_stream.use_count() > 1)
+    if (m_sinks.isEmpty())
         return;
 
-	if (m_handler)
-        m_handler->handle(LogMessage(m_level, m_stream->str(), m_context));
+    // The message is formatted once for all handlers
+    if (m_format)
+        m_sinks.handleRecord(LogRecord(m_level, m_format, m_context.name(), m_arguments));
+    else
+        m_sinks.handle(LogMessage(m_level, m_buffer.str(), m_context.name()));
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(const char * c)
 {
     assert(c != nullptr);
 
-    m_stream->write(c, std::strlen(c));
-	return *this;
+    if (beginText())
+        m_buffer.append(c, std::strlen(c));
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(const std::string & str)
 {
-    m_stream->write(str.c_str(), str.length());
-	return *this;
+    if (beginText())
+        m_buffer.append(str.c_str(), str.length());
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(bool b)
 {
 	*this << (b ? "true" : "false");
-	return *this;
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(char c)
 {
-    *m_stream << c;
-	return *this;
+    if (beginText())
+        m_buffer.appendCharacter(c);
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(int i)
 {
-    *m_stream << i;
-	return *this;
+    if (beginText())
+        m_buffer.appendInteger(i < 0 ? 0ull - static_cast<unsigned long long>(i) : static_cast<unsigned long long>(i), i < 0, true, sizeof(i));
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(float f)
 {
-    *m_stream << f;
-	return *this;
+    if (beginText())
+        m_buffer.appendFloat(f, false);
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(double d)
 {
-    *m_stream << d;
-	return *this;
+    if (beginText())
+        m_buffer.appendFloat(d, false);
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(long double d)
 {
-    *m_stream << d;
-	return *this;
+    if (beginText())
+        m_buffer.appendFloat(d, true);
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(unsigned u)
 {
-    *m_stream << u;
-	return *this;
+    if (beginText())
+        m_buffer.appendInteger(u, false, false, sizeof(u));
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(long l)
 {
-    *m_stream << l;
-	return *this;
+    if (beginText())
+        m_buffer.appendInteger(l < 0 ? 0ull - static_cast<unsigned long long>(l) : static_cast<unsigned long long>(l), l < 0, true, sizeof(l));
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(long long l)
 {
-    *m_stream << l;
+    if (beginText())
+        m_buffer.appendInteger(l < 0 ? 0ull - static_cast<unsigned long long>(l) : static_cast<unsigned long long>(l), l < 0, true, sizeof(l));
     return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(unsigned long ul)
 {
-    *m_stream << ul;
-	return *this;
+    if (beginText())
+        m_buffer.appendInteger(ul, false, false, sizeof(ul));
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(unsigned long long ul)
 {
-    *m_stream << ul;
+    if (beginText())
+        m_buffer.appendInteger(ul, false, false, sizeof(ul));
     return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(unsigned char uc)
 {
-    *m_stream << uc;
-	return *this;
+    if (beginText())
+        m_buffer.appendCharacter(static_cast<char>(uc));
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(const void * pointer)
 {
-    *m_stream << pointer;
-	return *this;
+    if (!beginText())
+        return *this;
+
+    // As std::num_put: hexadecimal with base prefix, ignoring the base and uppercase flags
+    const auto flags = m_buffer.flags();
+    m_buffer.setFlags((flags & ~(std::ios_base::basefield | std::ios_base::uppercase)) | std::ios_base::hex | std::ios_base::showbase);
+
+    m_buffer.appendInteger(reinterpret_cast<std::uintptr_t>(pointer), false, false, sizeof(pointer));
+
+    m_buffer.setFlags(flags);
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(std::ostream & (*manipulator)(std::ostream &))
 {
-    *m_stream << manipulator;
-	return *this;
+    if (!beginText())
+        return *this;
+
+    if (manipulator == static_cast<std::ostream & (*)(std::ostream &)>(std::endl))
+        m_buffer.append("\n", 1);
+    else if (manipulator != static_cast<std::ostream & (*)(std::ostream &)>(std::flush))
+        m_buffer.appendStreamed(manipulator);
+
+    return *this;
+}
+
+LogMessageBuilder & LogMessageBuilder::operator<<(std::ios_base & (*manipulator)(std::ios_base &))
+{
+    // E.g., std::hex or std::fixed, which would otherwise be taken for a bool
+    if (beginText())
+        m_buffer.appendStreamed(manipulator);
+    return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(LogMessageBuilder::PrecisionManipulator manipulator)
 {
-    *m_stream << manipulator;
+    if (beginText())
+        m_buffer.appendStreamed(manipulator);
     return *this;
 }
 
 LogMessageBuilder & LogMessageBuilder::operator<<(LogMessageBuilder::FillManipulator manipulator)
 {
-    *m_stream << manipulator;
+    if (beginText())
+        m_buffer.appendStreamed(manipulator);
     return *this;
 }
 
 #ifndef _MSC_VER
 LogMessageBuilder & LogMessageBuilder::operator<<(LogMessageBuilder::WidthManipulator manipulator)
 {
-    *m_stream << manipulator;
+    if (beginText())
+        m_buffer.appendStreamed(manipulator);
     return *this;
 }
 #endif
 
+bool LogMessageBuilder::beginText()
+{
+    if (m_sinks.isEmpty())
+        return false;
+
+    if (m_format)
+    {
+        LogRecord(m_level, m_format, std::string(), m_arguments).render(m_buffer);
+
+        m_format = nullptr;
+        m_arguments.clear();
+    }
+
+    return true;
+}
+
+bool LogMessageBuilder::isUntouched() const
+{
+    return m_buffer.size() == 0
+        && m_buffer.flags() == (std::ios_base::dec | std::ios_base::skipws)
+        && m_buffer.precision() == 6
+        && m_buffer.width() == 0
+        && m_buffer.fill() == ' ';
+}
+
 } // namespace loggingzeug
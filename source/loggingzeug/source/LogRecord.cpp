@@ -0,0 +1,313 @@
+
+#include <loggingzeug/LogRecord.h>
+
+#include <cstring>
+#include <memory>
+
+#include <loggingzeug/CompiledFormat.h>
+
+#include "binaryEncoding.h"
+
+
+namespace
+{
+
+using loggingzeug::LogRecord;
+
+void appendType(std::string & arguments, LogRecord::ArgumentType type, size_t size = 0)
+{
+    arguments += static_cast<char>(static_cast<unsigned char>(type) | (size << 4));
+}
+
+template <typename T>
+bool encodeSigned(std::string & arguments, T value)
+{
+    appendType(arguments, LogRecord::ArgumentType::SignedInteger, sizeof(T));
+    loggingzeug::appendVarint(arguments, loggingzeug::zigzagEncode(value));
+    return true;
+}
+
+template <typename T>
+bool encodeUnsigned(std::string & arguments, T value)
+{
+    appendType(arguments, LogRecord::ArgumentType::UnsignedInteger, sizeof(T));
+    loggingzeug::appendVarint(arguments, value);
+    return true;
+}
+
+template <typename T>
+bool encodeRaw(std::string & arguments, LogRecord::ArgumentType type, T value)
+{
+    appendType(arguments, type);
+    arguments.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool decodeRaw(const char *& data, const char * end, T & value)
+{
+    if (static_cast<size_t>(end - data) < sizeof(T))
+        return false;
+
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+
+    return true;
+}
+
+} // namespace
+
+
+namespace loggingzeug
+{
+
+LogRecord::LogRecord(LogMessage::Level level, const char * format, const std::string & context, const std::string & arguments)
+: m_level(level)
+, m_format(format)
+, m_context(context)
+, m_arguments(arguments)
+{
+}
+
+LogMessage::Level LogRecord::level() const
+{
+    return m_level;
+}
+
+const char * LogRecord::format() const
+{
+    return m_format;
+}
+
+const std::string & LogRecord::context() const
+{
+    return m_context;
+}
+
+const std::string & LogRecord::arguments() const
+{
+    return m_arguments;
+}
+
+void LogRecord::render(MessageBuffer & buffer) const
+{
+    if (!m_format)
+    {
+        buffer.append(m_arguments.data(), m_arguments.size());
+        return;
+    }
+
+    const auto cached = CompiledFormat::cached(m_format);
+    const auto compiled = cached ? std::unique_ptr<CompiledFormat>() : std::unique_ptr<CompiledFormat>(new CompiledFormat(m_format));
+    const auto & format = cached ? *cached : *compiled;
+
+    auto data = m_arguments.data();
+    const auto end = data + m_arguments.size();
+    auto index = static_cast<size_t>(0);
+
+    for (; data < end; ++index)
+    {
+        std::ios_base::fmtflags flags;
+
+        if (!format.beginArgument(buffer, index, flags))
+            return;
+
+        const auto valid = renderArgument(buffer, data, end);
+        buffer.setFlags(flags);
+
+        if (!valid)
+            return;
+    }
+
+    format.endArguments(buffer, index);
+}
+
+std::string LogRecord::message() const
+{
+    MessageBuffer buffer;
+    render(buffer);
+
+    return buffer.str();
+}
+
+bool LogRecord::encodeArguments(std::string & /*arguments*/)
+{
+    return true;
+}
+
+bool LogRecord::renderArgument(MessageBuffer & buffer, const char *& data, const char * end)
+{
+    const auto byte = static_cast<unsigned char>(*data++);
+    const auto size = static_cast<size_t>(byte >> 4);
+    unsigned long long value;
+
+    switch (static_cast<ArgumentType>(byte & 0x0f))
+    {
+    case ArgumentType::Boolean:
+        if (data == end)
+            return false;
+        detail::formatValue(buffer, *data++ != 0);
+        return true;
+
+    case ArgumentType::Character:
+        if (data == end)
+            return false;
+        buffer.appendCharacter(*data++);
+        return true;
+
+    case ArgumentType::SignedInteger:
+        if (!readVarint(data, end, value))
+            return false;
+        {
+            const auto signedValue = zigzagDecode(value);
+            const auto magnitude = static_cast<unsigned long long>(signedValue);
+            buffer.appendInteger(signedValue < 0 ? 0ull - magnitude : magnitude, signedValue < 0, true, size);
+        }
+        return true;
+
+    case ArgumentType::UnsignedInteger:
+        if (!readVarint(data, end, value))
+            return false;
+        buffer.appendInteger(value, false, false, size);
+        return true;
+
+    case ArgumentType::Double:
+        {
+            double d;
+            if (!decodeRaw(data, end, d))
+                return false;
+            buffer.appendFloat(d, false);
+        }
+        return true;
+
+    case ArgumentType::LongDouble:
+        {
+            long double d;
+            if (!decodeRaw(data, end, d))
+                return false;
+            buffer.appendFloat(d, true);
+        }
+        return true;
+
+    case ArgumentType::String:
+        if (!readVarint(data, end, value) || value > static_cast<unsigned long long>(end - data))
+            return false;
+        buffer.appendText(data, static_cast<size_t>(value));
+        data += value;
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+namespace detail
+{
+
+bool encodeValue(std::string & arguments, bool value)
+{
+    appendType(arguments, LogRecord::ArgumentType::Boolean);
+    arguments += static_cast<char>(value);
+    return true;
+}
+
+bool encodeValue(std::string & arguments, char value)
+{
+    appendType(arguments, LogRecord::ArgumentType::Character);
+    arguments += value;
+    return true;
+}
+
+bool encodeValue(std::string & arguments, signed char value)
+{
+    return encodeValue(arguments, static_cast<char>(value));
+}
+
+bool encodeValue(std::string & arguments, unsigned char value)
+{
+    return encodeValue(arguments, static_cast<char>(value));
+}
+
+bool encodeValue(std::string & arguments, short value)
+{
+    return encodeSigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, unsigned short value)
+{
+    return encodeUnsigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, int value)
+{
+    return encodeSigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, unsigned int value)
+{
+    return encodeUnsigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, long value)
+{
+    return encodeSigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, unsigned long value)
+{
+    return encodeUnsigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, long long value)
+{
+    return encodeSigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, unsigned long long value)
+{
+    return encodeUnsigned(arguments, value);
+}
+
+bool encodeValue(std::string & arguments, float value)
+{
+    // Streamed floats are converted to double as well
+    return encodeRaw(arguments, LogRecord::ArgumentType::Double, static_cast<double>(value));
+}
+
+bool encodeValue(std::string & arguments, double value)
+{
+    return encodeRaw(arguments, LogRecord::ArgumentType::Double, value);
+}
+
+bool encodeValue(std::string & arguments, long double value)
+{
+    return encodeRaw(arguments, LogRecord::ArgumentType::LongDouble, value);
+}
+
+bool encodeValue(std::string & arguments, char * value)
+{
+    return encodeValue(arguments, static_cast<const char *>(value));
+}
+
+bool encodeValue(std::string & arguments, const char * value)
+{
+    // Null strings are written as nothing
+    const auto size = value ? std::strlen(value) : 0;
+
+    appendType(arguments, LogRecord::ArgumentType::String);
+    appendVarint(arguments, size);
+    arguments.append(value ? value : "", size);
+    return true;
+}
+
+bool encodeValue(std::string & arguments, const std::string & value)
+{
+    appendType(arguments, LogRecord::ArgumentType::String);
+    appendVarint(arguments, value.size());
+    arguments.append(value);
+    return true;
+}
+
+} // namespace detail
+
+} // namespace loggingzeug
@@ -0,0 +1,314 @@
+#include <loggingzeug/LogSinks.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/ConsoleLogHandler.h>
+#include <loggingzeug/LogRecord.h>
+#include <loggingzeug/logging.h>
+
+namespace loggingzeug
+{
+
+namespace detail
+{
+
+struct LogSink
+{
+    AbstractLogHandler * handler;
+    LogMessage::Level verbosity;
+};
+
+struct LogSinkList
+{
+    explicit LogSinkList(std::vector<LogSink> list)
+    : sinks(std::move(list))
+    , maximumLevel(-1)
+    , handlesRecords(false)
+    {
+        for (const auto & sink : sinks)
+        {
+            maximumLevel = std::max(maximumLevel, static_cast<int>(sink.verbosity));
+            handlesRecords = handlesRecords || sink.handler->handlesRecords();
+        }
+    }
+
+    const std::vector<LogSink> sinks;
+    int maximumLevel;
+    bool handlesRecords;
+};
+
+} // namespace detail
+
+} // namespace loggingzeug
+
+namespace
+{
+
+using loggingzeug::detail::LogSink;
+using loggingzeug::detail::LogSinkList;
+
+struct Registry
+{
+    Registry()
+    : current(new LogSinkList({ { new loggingzeug::ConsoleLogHandler, loggingzeug::LogMessage::Info } }))
+    , maximumLevel(current.load()->maximumLevel)
+    , epoch(0)
+    {
+        readers[0] = 0;
+        readers[1] = 0;
+    }
+
+    // Replaces the list and deletes the handlers that are not in the new one; requires the mutex
+    void publish(std::vector<LogSink> sinks)
+    {
+        const auto list = new LogSinkList(std::move(sinks));
+        const auto previous = current.exchange(list);
+
+        maximumLevel = list->maximumLevel;
+
+        // Readers that pinned the previous list counted themselves in the slot of the
+        // current epoch; new readers count in the other slot and see the new list
+        const auto slot = epoch.fetch_add(1) & 1;
+
+        while (readers[slot].load() != 0)
+            std::this_thread::yield();
+
+        for (const auto & sink : previous->sinks)
+        {
+            const auto kept = std::any_of(list->sinks.begin(), list->sinks.end(), [&sink] (const LogSink & other) {
+                return other.handler == sink.handler;
+            });
+
+            if (!kept)
+                delete sink.handler;
+        }
+
+        delete previous;
+    }
+
+    std::mutex mutex;   // serializes changes
+    std::atomic<const LogSinkList *> current;
+    std::atomic<int> maximumLevel;
+    std::atomic<size_t> epoch;
+    std::atomic<size_t> readers[2];
+};
+
+Registry & registry()
+{
+    // Never destroyed, as messages may be logged during static destruction
+    static const auto registry = new Registry;
+
+    return *registry;
+}
+
+} // namespace
+
+namespace loggingzeug
+{
+
+LogSinks::LogSinks()
+: m_list(nullptr)
+, m_slot(0)
+, m_handler(nullptr)
+{
+}
+
+LogSinks::LogSinks(AbstractLogHandler * handler)
+: m_list(nullptr)
+, m_slot(0)
+, m_handler(handler)
+{
+}
+
+LogSinks::LogSinks(LogSinks && sinks)
+: m_list(sinks.m_list)
+, m_slot(sinks.m_slot)
+, m_handler(sinks.m_handler)
+{
+    sinks.m_list = nullptr;
+    sinks.m_handler = nullptr;
+}
+
+LogSinks::~LogSinks()
+{
+    if (m_list)
+        registry().readers[m_slot].fetch_sub(1, std::memory_order_release);
+}
+
+LogSinks LogSinks::acquire(LogMessage::Level level)
+{
+    auto & sinks = registry();
+
+    size_t slot;
+
+    for (;;)
+    {
+        const auto epoch = sinks.epoch.load();
+        slot = epoch & 1;
+
+        sinks.readers[slot].fetch_add(1);
+
+        // A change that started in between may already wait for the other slot
+        if (sinks.epoch.load() == epoch)
+            break;
+
+        sinks.readers[slot].fetch_sub(1);
+    }
+
+    const auto list = sinks.current.load();
+
+    LogSinks result;
+
+    if (static_cast<int>(level) > list->maximumLevel)
+    {
+        sinks.readers[slot].fetch_sub(1, std::memory_order_release);
+        return result;
+    }
+
+    result.m_list = list;
+    result.m_slot = slot;
+
+    return result;
+}
+
+bool LogSinks::isEmpty() const
+{
+    return !m_list && !m_handler;
+}
+
+bool LogSinks::handlesRecords() const
+{
+    if (m_handler)
+        return m_handler->handlesRecords();
+
+    return m_list && m_list->handlesRecords;
+}
+
+template <typename Callback>
+void LogSinks::dispatch(LogMessage::Level level, Callback callback) const
+{
+    if (m_handler)
+    {
+        callback(m_handler);
+        return;
+    }
+
+    if (!m_list)
+        return;
+
+    for (const auto & sink : m_list->sinks)
+    {
+        if (level <= sink.verbosity)
+            callback(sink.handler);
+    }
+}
+
+void LogSinks::handle(const LogMessage & message) const
+{
+    dispatch(message.level(), [&message] (AbstractLogHandler * handler) {
+        handler->handle(message);
+    });
+}
+
+void LogSinks::handleRecord(const LogRecord & record) const
+{
+    // Rendered on demand, once for all handlers that do not take records
+    std::unique_ptr<LogMessage> message;
+
+    dispatch(record.level(), [&record, &message] (AbstractLogHandler * handler) {
+        if (handler->handlesRecords())
+        {
+            handler->handleRecord(record);
+            return;
+        }
+
+        if (!message)
+            message.reset(new LogMessage(record.level(), record.message(), record.context()));
+
+        handler->handle(*message);
+    });
+}
+
+void LogSinks::add(AbstractLogHandler * handler, LogMessage::Level verbosity)
+{
+    assert(handler != nullptr);
+
+    auto & sinks = registry();
+
+    {
+        std::lock_guard<std::mutex> lock(sinks.mutex);
+
+        auto list = sinks.current.load()->sinks;
+
+        const auto it = std::find_if(list.begin(), list.end(), [handler] (const LogSink & sink) {
+            return sink.handler == handler;
+        });
+
+        if (it != list.end())
+            it->verbosity = verbosity;
+        else
+            list.push_back({ handler, verbosity });
+
+        sinks.publish(std::move(list));
+    }
+
+    detail::updateEnabledLevel();
+}
+
+void LogSinks::remove(AbstractLogHandler * handler)
+{
+    auto & sinks = registry();
+
+    {
+        std::lock_guard<std::mutex> lock(sinks.mutex);
+
+        auto list = sinks.current.load()->sinks;
+
+        list.erase(std::remove_if(list.begin(), list.end(), [handler] (const LogSink & sink) {
+            return sink.handler == handler;
+        }), list.end());
+
+        sinks.publish(std::move(list));
+    }
+
+    detail::updateEnabledLevel();
+}
+
+void LogSinks::reset(AbstractLogHandler * handler)
+{
+    auto & sinks = registry();
+
+    {
+        std::lock_guard<std::mutex> lock(sinks.mutex);
+
+        auto list = std::vector<LogSink>();
+
+        if (handler)
+            list.push_back({ handler, LogMessage::Info });
+
+        sinks.publish(std::move(list));
+    }
+
+    detail::updateEnabledLevel();
+}
+
+AbstractLogHandler * LogSinks::first()
+{
+    const auto sinks = acquire(LogMessage::Fatal);
+
+    return sinks.m_list ? sinks.m_list->sinks.front().handler : nullptr;
+}
+
+int LogSinks::maximumVerbosityLevel()
+{
+    return registry().maximumLevel.load(std::memory_order_relaxed);
+}
+
+} // namespace loggingzeug
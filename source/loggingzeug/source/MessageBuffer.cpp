@@ -0,0 +1,407 @@
+
+#include <loggingzeug/MessageBuffer.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+
+struct FormatStream
+{
+    FormatStream()
+    : stream(&buffer)
+    {
+    }
+
+    std::stringbuf buffer;
+    std::ostream stream;
+};
+
+// One stream per nesting level, as streamed values may format messages themselves
+struct FormatStreams
+{
+    FormatStreams()
+    : depth(0)
+    {
+    }
+
+    std::vector<std::unique_ptr<FormatStream>> streams;
+    size_t depth;
+};
+
+FormatStreams & formatStreams()
+{
+    static thread_local FormatStreams formatStreams;
+
+    return formatStreams;
+}
+
+const char * const lowerDigits = "0123456789abcdef";
+const char * const upperDigits = "0123456789ABCDEF";
+
+// Writes the digits of value backwards, ending at end, and returns the first digit
+char * writeDigits(char * end, unsigned long long value, unsigned base, const char * digits)
+{
+    do
+    {
+        *--end = digits[value % base];
+        value /= base;
+    }
+    while (value != 0);
+
+    return end;
+}
+
+} // namespace
+
+
+namespace loggingzeug
+{
+
+const size_t MessageBuffer::InlineCapacity;
+
+MessageBuffer::MessageBuffer()
+: m_data(m_inline)
+, m_size(0)
+, m_capacity(InlineCapacity)
+, m_flags(std::ios_base::dec | std::ios_base::skipws)
+, m_precision(6)
+, m_width(0)
+, m_fill(' ')
+{
+}
+
+MessageBuffer::MessageBuffer(MessageBuffer && buffer)
+: m_data(m_inline)
+, m_size(buffer.m_size)
+, m_capacity(buffer.m_capacity)
+, m_flags(buffer.m_flags)
+, m_precision(buffer.m_precision)
+, m_width(buffer.m_width)
+, m_fill(buffer.m_fill)
+{
+    if (buffer.m_data == buffer.m_inline)
+    {
+        std::memcpy(m_inline, buffer.m_inline, m_size);
+    }
+    else
+    {
+        m_data = buffer.m_data;
+        buffer.m_data = buffer.m_inline;
+        buffer.m_capacity = InlineCapacity;
+    }
+
+    buffer.m_size = 0;
+}
+
+MessageBuffer::~MessageBuffer()
+{
+    if (m_data != m_inline)
+        delete[] m_data;
+}
+
+const char * MessageBuffer::data() const
+{
+    return m_data;
+}
+
+size_t MessageBuffer::size() const
+{
+    return m_size;
+}
+
+std::string MessageBuffer::str() const
+{
+    return std::string(m_data, m_size);
+}
+
+void MessageBuffer::clear()
+{
+    m_size = 0;
+}
+
+std::ios_base::fmtflags MessageBuffer::flags() const
+{
+    return m_flags;
+}
+
+void MessageBuffer::setFlags(std::ios_base::fmtflags flags)
+{
+    m_flags = flags;
+}
+
+std::streamsize MessageBuffer::precision() const
+{
+    return m_precision;
+}
+
+void MessageBuffer::setPrecision(std::streamsize precision)
+{
+    m_precision = precision;
+}
+
+std::streamsize MessageBuffer::width() const
+{
+    return m_width;
+}
+
+void MessageBuffer::setWidth(std::streamsize width)
+{
+    m_width = width;
+}
+
+char MessageBuffer::fill() const
+{
+    return m_fill;
+}
+
+void MessageBuffer::setFill(char fill)
+{
+    m_fill = fill;
+}
+
+void MessageBuffer::append(const char * data, size_t size)
+{
+    if (m_size + size > m_capacity)
+    {
+        auto capacity = m_capacity * 2;
+        while (capacity < m_size + size)
+            capacity *= 2;
+
+        const auto buffer = new char[capacity];
+        std::memcpy(buffer, m_data, m_size);
+
+        if (m_data != m_inline)
+            delete[] m_data;
+
+        m_data = buffer;
+        m_capacity = capacity;
+    }
+
+    std::memcpy(m_data + m_size, data, size);
+    m_size += size;
+}
+
+void MessageBuffer::appendText(const char * data, size_t size)
+{
+    // Text is never padded internally
+    if ((m_flags & std::ios_base::adjustfield) == std::ios_base::internal && m_width > static_cast<std::streamsize>(size))
+    {
+        const auto flags = m_flags;
+        m_flags = (flags & ~std::ios_base::adjustfield) | std::ios_base::right;
+        appendPadded(data, size, 0);
+        m_flags = flags;
+        return;
+    }
+
+    appendPadded(data, size, 0);
+}
+
+void MessageBuffer::appendCharacter(char c)
+{
+    appendText(&c, 1);
+}
+
+void MessageBuffer::appendInteger(unsigned long long magnitude, bool negative, bool isSigned, size_t size)
+{
+    // Sign, base prefix and up to 64 binary digits
+    char buffer[72];
+    char * const end = buffer + sizeof(buffer);
+
+    const auto base = m_flags & std::ios_base::basefield;
+    const auto uppercase = (m_flags & std::ios_base::uppercase) != 0;
+    const auto showbase = (m_flags & std::ios_base::showbase) != 0;
+
+    char * begin;
+    size_t internalOffset = 0;
+
+    if (base == std::ios_base::hex || base == std::ios_base::oct)
+    {
+        // As in std::num_put, negative numbers are written as their unsigned representation
+        const auto mask = size < sizeof(unsigned long long) ? (1ull << (size * 8)) - 1 : ~0ull;
+        const auto value = (negative ? 0ull - magnitude : magnitude) & mask;
+
+        if (base == std::ios_base::hex)
+        {
+            begin = writeDigits(end, value, 16, uppercase ? upperDigits : lowerDigits);
+
+            if (showbase && value != 0)
+            {
+                *--begin = uppercase ? 'X' : 'x';
+                *--begin = '0';
+                internalOffset = 2;
+            }
+        }
+        else
+        {
+            begin = writeDigits(end, value, 8, lowerDigits);
+
+            if (showbase && value != 0)
+                *--begin = '0';
+        }
+    }
+    else
+    {
+        begin = writeDigits(end, magnitude, 10, lowerDigits);
+
+        if (negative)
+        {
+            *--begin = '-';
+            internalOffset = 1;
+        }
+        else if (isSigned && (m_flags & std::ios_base::showpos))
+        {
+            *--begin = '+';
+            internalOffset = 1;
+        }
+    }
+
+    appendPadded(begin, static_cast<size_t>(end - begin), internalOffset);
+}
+
+void MessageBuffer::appendFloat(long double value, bool isLong)
+{
+    // Same conversion as std::num_put
+    char format[8];
+    char * f = format;
+
+    *f++ = '%';
+    if (m_flags & std::ios_base::showpos)
+        *f++ = '+';
+    if (m_flags & std::ios_base::showpoint)
+        *f++ = '#';
+
+    const auto floatfield = m_flags & std::ios_base::floatfield;
+    const auto uppercase = (m_flags & std::ios_base::uppercase) != 0;
+    const auto hexfloat = floatfield == (std::ios_base::fixed | std::ios_base::scientific);
+
+    if (!hexfloat)
+    {
+        *f++ = '.';
+        *f++ = '*';
+    }
+    if (isLong)
+        *f++ = 'L';
+
+    if (floatfield == std::ios_base::fixed)
+        *f++ = 'f'; // as libstdc++, which ignores uppercase for fixed notation
+    else if (floatfield == std::ios_base::scientific)
+        *f++ = uppercase ? 'E' : 'e';
+    else if (hexfloat)
+        *f++ = uppercase ? 'A' : 'a';
+    else
+        *f++ = uppercase ? 'G' : 'g';
+
+    *f = '\0';
+
+    const auto precision = static_cast<int>(m_precision < 0 ? 6 : m_precision);
+
+    // Large numbers in fixed notation exceed the buffer
+    char buffer[128];
+    std::string large;
+    const char * result = buffer;
+
+    auto length = hexfloat
+        ? (isLong ? std::snprintf(buffer, sizeof(buffer), format, value) : std::snprintf(buffer, sizeof(buffer), format, static_cast<double>(value)))
+        : (isLong ? std::snprintf(buffer, sizeof(buffer), format, precision, value) : std::snprintf(buffer, sizeof(buffer), format, precision, static_cast<double>(value)));
+
+    if (length < 0)
+        return;
+
+    if (static_cast<size_t>(length) >= sizeof(buffer))
+    {
+        large.resize(static_cast<size_t>(length) + 1);
+
+        length = hexfloat
+            ? (isLong ? std::snprintf(&large[0], large.size(), format, value) : std::snprintf(&large[0], large.size(), format, static_cast<double>(value)))
+            : (isLong ? std::snprintf(&large[0], large.size(), format, precision, value) : std::snprintf(&large[0], large.size(), format, precision, static_cast<double>(value)));
+
+        result = large.data();
+    }
+
+    size_t internalOffset = 0;
+    if (result[0] == '-' || result[0] == '+')
+        ++internalOffset;
+    if (hexfloat && result[internalOffset] == '0' && (result[internalOffset + 1] == 'x' || result[internalOffset + 1] == 'X'))
+        internalOffset += 2;
+
+    appendPadded(result, static_cast<size_t>(length), internalOffset);
+}
+
+void MessageBuffer::appendPadded(const char * data, size_t size, size_t internalOffset)
+{
+    const auto width = static_cast<size_t>(m_width > 0 ? m_width : 0);
+    m_width = 0;
+
+    if (width <= size)
+    {
+        append(data, size);
+        return;
+    }
+
+    const auto adjust = m_flags & std::ios_base::adjustfield;
+    const auto padding = std::string(width - size, m_fill);
+
+    if (adjust == std::ios_base::left)
+    {
+        append(data, size);
+        append(padding.data(), padding.size());
+    }
+    else if (adjust == std::ios_base::internal)
+    {
+        append(data, internalOffset);
+        append(padding.data(), padding.size());
+        append(data + internalOffset, size - internalOffset);
+    }
+    else
+    {
+        append(padding.data(), padding.size());
+        append(data, size);
+    }
+}
+
+MessageBuffer::StreamScope::StreamScope(MessageBuffer & buffer)
+: m_buffer(buffer)
+{
+    auto & streams = formatStreams();
+
+    if (streams.depth == streams.streams.size())
+        streams.streams.emplace_back(new FormatStream);
+
+    auto & format = *streams.streams[streams.depth++];
+
+    format.buffer.str(std::string());
+    format.stream.clear();
+    format.stream.flags(buffer.m_flags);
+    format.stream.precision(buffer.m_precision);
+    format.stream.width(buffer.m_width);
+    format.stream.fill(buffer.m_fill);
+
+    m_stream = &format.stream;
+}
+
+MessageBuffer::StreamScope::~StreamScope()
+{
+    auto & streams = formatStreams();
+    auto & format = *streams.streams[--streams.depth];
+
+    const auto written = format.buffer.str();
+    m_buffer.append(written.data(), written.size());
+
+    m_buffer.m_flags = format.stream.flags();
+    m_buffer.m_precision = format.stream.precision();
+    m_buffer.m_width = format.stream.width();
+    m_buffer.m_fill = format.stream.fill();
+}
+
+std::ostream & MessageBuffer::StreamScope::stream()
+{
+    return *m_stream;
+}
+
+} // namespace loggingzeug
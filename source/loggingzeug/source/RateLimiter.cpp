@@ -0,0 +1,46 @@
+#include <loggingzeug/RateLimiter.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace loggingzeug
+{
+
+RateLimiter::RateLimiter(double messagesPerSecond, size_t burst)
+: m_interval(static_cast<long long>(1e9 / messagesPerSecond))
+, m_tolerance(static_cast<long long>(burst > 0 ? burst - 1 : 0) * m_interval)
+, m_next(0)
+, m_suppressed(0)
+{
+    assert(messagesPerSecond > 0.0);
+}
+
+bool RateLimiter::acquire()
+{
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    auto next = m_next.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        // The bucket has room for another token unless it would be refilled too far into the future
+        const auto start = std::max(next, static_cast<long long>(now));
+
+        if (start - now > m_tolerance)
+        {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (m_next.compare_exchange_weak(next, start + m_interval, std::memory_order_relaxed))
+            return true;
+    }
+}
+
+size_t RateLimiter::suppressed() const
+{
+    return m_suppressed.load(std::memory_order_relaxed);
+}
+
+} // namespace loggingzeug
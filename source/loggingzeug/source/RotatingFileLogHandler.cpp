@@ -0,0 +1,180 @@
+#include <loggingzeug/RotatingFileLogHandler.h>
+
+#include <cassert>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace loggingzeug
+{
+
+RotatingFileLogHandler::RotatingFileLogHandler(const std::string & logfile, size_t maximumSize, size_t generations, size_t bufferSize)
+: FileLogHandler(logfile)
+, m_maximumSize(maximumSize)
+, m_generations(generations)
+, m_bufferSize(bufferSize)
+, m_rotationInterval(0)
+, m_syncPolicy(SyncPolicy::Never)
+, m_file(nullptr)
+, m_size(0)
+{
+    assert(maximumSize > 0);
+
+    m_buffer.reserve(m_bufferSize);
+
+    open();
+}
+
+RotatingFileLogHandler::~RotatingFileLogHandler()
+{
+    writeBuffer(m_syncPolicy != SyncPolicy::Never);
+
+    if (m_file)
+        std::fclose(m_file);
+}
+
+void RotatingFileLogHandler::handle(const LogMessage & message)
+{
+    const auto prefix = messagePrefix(message);
+    const auto size = prefix.size() + message.message().size() + 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto expired = m_rotationInterval.count() > 0 && std::chrono::steady_clock::now() - m_opened >= m_rotationInterval;
+
+    if (m_size > 0 && (m_size + size > m_maximumSize || expired))
+        rotate();
+
+    if (m_buffer.size() + size > m_bufferSize)
+        writeBuffer(m_syncPolicy == SyncPolicy::PerBatch);
+
+    m_buffer += prefix;
+    m_buffer += message.message();
+    m_buffer += '\n';
+    m_size += size;
+
+    // Critical messages must not be lost in the buffer
+    if (message.level() <= LogMessage::Critical)
+        writeBuffer(m_syncPolicy != SyncPolicy::Never);
+}
+
+void RotatingFileLogHandler::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    writeBuffer(m_syncPolicy != SyncPolicy::Never);
+}
+
+size_t RotatingFileLogHandler::maximumSize() const
+{
+    return m_maximumSize;
+}
+
+size_t RotatingFileLogHandler::generations() const
+{
+    return m_generations;
+}
+
+std::chrono::seconds RotatingFileLogHandler::rotationInterval() const
+{
+    return m_rotationInterval;
+}
+
+void RotatingFileLogHandler::setRotationInterval(std::chrono::seconds interval)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_rotationInterval = interval;
+}
+
+RotatingFileLogHandler::SyncPolicy RotatingFileLogHandler::syncPolicy() const
+{
+    return m_syncPolicy;
+}
+
+void RotatingFileLogHandler::setSyncPolicy(SyncPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_syncPolicy = policy;
+}
+
+void RotatingFileLogHandler::open()
+{
+    m_file = std::fopen(m_logfile.c_str(), "ab");
+    m_size = 0;
+    m_opened = std::chrono::steady_clock::now();
+
+    if (!m_file)
+        return;
+
+    // The handler buffers itself, so that each batch is a single write
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    std::fseek(m_file, 0, SEEK_END);
+    const auto size = std::ftell(m_file);
+
+    if (size > 0)
+        m_size = static_cast<size_t>(size);
+}
+
+void RotatingFileLogHandler::rotate()
+{
+    writeBuffer(m_syncPolicy != SyncPolicy::Never);
+
+    if (m_file)
+        std::fclose(m_file);
+
+    if (m_generations == 0)
+    {
+        std::remove(m_logfile.c_str());
+    }
+    else
+    {
+        std::remove(generationName(m_logfile, m_generations).c_str());
+
+        for (auto generation = m_generations - 1; generation > 0; --generation)
+            std::rename(generationName(m_logfile, generation).c_str(), generationName(m_logfile, generation + 1).c_str());
+
+        std::rename(m_logfile.c_str(), generationName(m_logfile, 1).c_str());
+    }
+
+    open();
+}
+
+void RotatingFileLogHandler::writeBuffer(bool sync)
+{
+    if (!m_file)
+    {
+        m_buffer.clear();
+        return;
+    }
+
+    if (!m_buffer.empty())
+    {
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_buffer.clear();
+    }
+
+    if (sync)
+        this->sync();
+}
+
+void RotatingFileLogHandler::sync()
+{
+#ifdef WIN32
+    _commit(_fileno(m_file));
+#else
+    fsync(fileno(m_file));
+#endif
+}
+
+std::string RotatingFileLogHandler::generationName(const std::string & logfile, size_t generation)
+{
+    return logfile + "." + std::to_string(generation);
+}
+
+} // namespace loggingzeug
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace loggingzeug
+{
+
+// Building blocks of LogRecord arguments and binary log files
+
+// A binary log file starts with the magic, the version and sizeof(long double),
+// followed by entries starting with their BinaryLogEntry:
+//   Format:  id, size, characters - ids start at 1
+//   Context: id, size, characters - ids start at 0
+//   Record:  level byte, context id, format id (0 for text), size, encoded arguments or text
+//   Session: no data - starts a session appended to the file; the ids of the following
+//            formats and contexts start over and only refer to the definitions after it
+// All ids and sizes are written by appendVarint.
+const char binaryLogMagic[4] = { 'L', 'Z', 'B', 'L' };
+const unsigned char binaryLogVersion = 1;
+
+enum class BinaryLogEntry : unsigned char
+{
+    Format = 'F',
+    Context = 'C',
+    Record = 'R',
+    Session = 'S'
+};
+
+// Writes an unsigned integer in 7-bit groups, least significant first; the high bit marks continuation
+inline void appendVarint(std::string & data, unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        data += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+
+    data += static_cast<char>(value);
+}
+
+// Reads an integer written by appendVarint, or returns false if the data ends before it
+inline bool readVarint(const char *& data, const char * end, unsigned long long & value)
+{
+    value = 0;
+
+    for (unsigned shift = 0; data < end && shift < 64; shift += 7)
+    {
+        const auto byte = static_cast<unsigned char>(*data++);
+        value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// Maps signed integers to unsigned ones with small magnitudes staying small
+inline unsigned long long zigzagEncode(long long value)
+{
+    return (static_cast<unsigned long long>(value) << 1) ^ (value < 0 ? ~0ull : 0ull);
+}
+
+inline long long zigzagDecode(unsigned long long value)
+{
+    return static_cast<long long>((value >> 1) ^ (0ull - (value & 1)));
+}
+
+} // namespace loggingzeug
@@ -1,23 +1,44 @@
 #include <loggingzeug/logging.h>
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 
 #include <loggingzeug/AbstractLogHandler.h>
 #include <loggingzeug/LogMessageBuilder.h>
-#include <loggingzeug/ConsoleLogHandler.h>
+#include <loggingzeug/LogSinks.h>
 
 namespace
 {
-    loggingzeug::LogMessage::Level l_verbosityLevel = loggingzeug::LogMessage::Info;
-    loggingzeug::AbstractLogHandler * l_logHandler = new loggingzeug::ConsoleLogHandler();
+    std::atomic<int> l_verbosityLevel(loggingzeug::LogMessage::Info);
+
+    // Serializes the updates of the enabled level, so that the last one reads the latest inputs
+    std::mutex l_enabledLevelMutex;
 }
 
 namespace loggingzeug
 {
 
+namespace detail
+{
+
+std::atomic<int> enabledLevel(LogMessage::Info);
+
+void updateEnabledLevel()
+{
+    std::lock_guard<std::mutex> lock(l_enabledLevelMutex);
+
+    enabledLevel = std::min(static_cast<int>(LogContext::maximumVerbosityLevel()), LogSinks::maximumVerbosityLevel());
+}
+
+} // namespace detail
+
 LogMessageBuilder info(const std::string & context, LogMessage::Level level)
 {
-    return LogMessageBuilder(level, level <= l_verbosityLevel ? l_logHandler : nullptr, context);
+    if (!isEnabled(level))
+        return LogMessageBuilder(level, LogSinks(), LogContext());
+
+    return info(LogContext(context), level);
 }
 
 LogMessageBuilder debug(const std::string & context)
@@ -40,25 +61,69 @@ LogMessageBuilder fatal(const std::string & context)
     return info(context, LogMessage::Fatal);
 }
 
+LogMessageBuilder info(const LogContext & context, LogMessage::Level level)
+{
+    if (!isEnabled(level) || !context.includes(level))
+        return LogMessageBuilder(level, LogSinks(), context);
+
+    return LogMessageBuilder(level, LogSinks::acquire(level), context);
+}
+
+LogMessageBuilder debug(const LogContext & context)
+{
+    return info(context, LogMessage::Debug);
+}
+
+LogMessageBuilder warning(const LogContext & context)
+{
+    return info(context, LogMessage::Warning);
+}
+
+LogMessageBuilder critical(const LogContext & context)
+{
+    return info(context, LogMessage::Critical);
+}
+
+LogMessageBuilder fatal(const LogContext & context)
+{
+    return info(context, LogMessage::Fatal);
+}
+
 AbstractLogHandler * loggingHandler()
 {
-    return l_logHandler;
+    return LogSinks::first();
 }
 
 void setLoggingHandler(AbstractLogHandler* handler)
 {
-    delete l_logHandler;
-    l_logHandler = handler;
+    LogSinks::reset(handler);
+}
+
+void addLoggingHandler(AbstractLogHandler * handler, LogMessage::Level verbosity)
+{
+    LogSinks::add(handler, verbosity);
+}
+
+void removeLoggingHandler(AbstractLogHandler * handler)
+{
+    LogSinks::remove(handler);
 }
 
 void setVerbosityLevel(LogMessage::Level verbosity)
 {
     l_verbosityLevel = verbosity;
+
+    detail::updateEnabledLevel();
 }
 
 LogMessage::Level verbosityLevel()
 {
-    return l_verbosityLevel;
+    return static_cast<LogMessage::Level>(l_verbosityLevel.load(std::memory_order_relaxed));
+}
+
+void setVerbosityLevel(const std::string & context, LogMessage::Level verbosity)
+{
+    LogContext(context).setVerbosityLevel(verbosity);
 }
 
 } // namespace loggingzeug
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <vector>
+
 #include <QAbstractItemModel>
+#include <QSet>
 
 #include <propertyguizeug/propertyguizeug_api.h>
 
@@ -49,6 +52,12 @@ public:
 
     void onValueChanged(PropertyItem * item);
 
+    /** Emits one dataChanged per contiguous range of changed rows below item,
+     *  instead of one per property, after a batch update of its group.
+     */
+    void onValuesChanged(PropertyItem * item,
+                         const std::vector<reflectionzeug::AbstractProperty *> & properties);
+
     void onBeforeAdd(PropertyItem * item, 
                      size_t position, 
                      reflectionzeug::AbstractProperty * property);
@@ -66,6 +75,9 @@ private:
                          reflectionzeug::AbstractProperty * property);
 
     QModelIndex createIndex(PropertyItem * item, int column = 0) const;
+
+    void emitDataChanged(PropertyItem * item,
+                         const QSet<const reflectionzeug::AbstractProperty *> & properties);
     
 private:
     PropertyItem * m_root;
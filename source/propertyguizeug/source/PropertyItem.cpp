@@ -34,7 +34,8 @@ PropertyItem::PropertyItem(
                 group->beforeAdd.connect([this, model](size_t position, AbstractProperty * property) { model->onBeforeAdd(this, position, property); }),
                 group->afterAdd.onFire([this, model]() { model->onAfterAdd(); }),
                 group->beforeRemove.connect([this, model](size_t position) { model->onBeforeRemove(this, position); }),
-                group->afterRemove.onFire([this, model]() { model->onAfterRemove(); })
+                group->afterRemove.onFire([this, model]() { model->onAfterRemove(); }),
+                group->valuesChanged.connect([this, model](const std::vector<AbstractProperty *> & properties) { model->onValuesChanged(this, properties); })
             });
         }
     }
@@ -136,11 +136,33 @@ QVariant PropertyModel::headerData(int section, Qt::Orientation /*orientation*/,
 
 void PropertyModel::onValueChanged(PropertyItem * item)
 {
+    // Changes notified by a batch update are handled by onValuesChanged
+    for (PropertyItem * ancestor = item->parent(); ancestor; ancestor = ancestor->parent())
+    {
+        PropertyGroup * group = ancestor->property()->asGroup();
+
+        if (group && group->isNotifyingBatch())
+            return;
+    }
+
     QModelIndex index = createIndex(item, 1);
 
     emit dataChanged(index, index);
 }
 
+void PropertyModel::onValuesChanged(
+    PropertyItem * item,
+    const std::vector<AbstractProperty *> & properties)
+{
+    QSet<const AbstractProperty *> changed;
+    changed.reserve(static_cast<int>(properties.size()));
+
+    for (AbstractProperty * property : properties)
+        changed.insert(property);
+
+    emitDataChanged(item, changed);
+}
+
 void PropertyModel::onBeforeAdd(
     PropertyItem * item, 
     size_t position, 
@@ -176,4 +198,32 @@ QModelIndex PropertyModel::createIndex(PropertyItem * item, int column) const
     return QAbstractItemModel::createIndex(item->index(), column, item);
 }
 
+void PropertyModel::emitDataChanged(
+    PropertyItem * item,
+    const QSet<const AbstractProperty *> & properties)
+{
+    const int count = static_cast<int>(item->childCount());
+
+    int first = -1;
+
+    for (int row = 0; row <= count; ++row)
+    {
+        PropertyItem * child = row < count ? item->at(row) : nullptr;
+        const bool changed = child && properties.contains(child->property());
+
+        if (changed && first < 0)
+            first = row;
+
+        // End of a contiguous range of changed rows
+        if (!changed && first >= 0)
+        {
+            emit dataChanged(createIndex(item->at(first), 1), createIndex(item->at(row - 1), 1));
+            first = -1;
+        }
+
+        if (child && child->hasChildren())
+            emitDataChanged(child, properties);
+    }
+}
+
 } // namespace propertyguizeug
@@ -96,6 +96,12 @@ template <typename Type, size_t Size>
 void AbstractArrayProperty<Type, Size>::setElement(size_t i, const Type & value)
 {
     m_arrayAccessor->setElement(i, value);
+
+    // Notify later if the property is part of a batch update
+    if (this->deferNotification()) {
+        return;
+    }
+
     this->valueChanged(this->value());
     this->changed();
 }
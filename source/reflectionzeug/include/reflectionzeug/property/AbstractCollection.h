@@ -3,6 +3,7 @@
 
 
 #include <functional>
+#include <cstddef>
 
 #include <reflectionzeug/reflectionzeug_api.h>
 
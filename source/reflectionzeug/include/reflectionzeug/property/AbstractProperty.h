@@ -17,6 +17,7 @@ class AbstractValueProperty;
 class AbstractCollection;
 class PropertyGroup;
 class AbstractVisitor;
+class BatchUpdate;
 
 
 /**
@@ -30,6 +31,9 @@ class AbstractVisitor;
 */
 class REFLECTIONZEUG_API AbstractProperty
 {
+    friend class BatchUpdate;
+
+
 public:
     static const std::string s_nameRegexString;             ///< RegEx for a valid property name
 
@@ -312,8 +316,30 @@ public:
 
 
 protected:
-    std::string m_name;     ///< Property name
-    VariantMap  m_options;  ///< List of options
+    /**
+    *  @brief
+    *    Invoke the change signals of the property
+    *
+    *    Called by BatchUpdate for each property that has been changed during the batch.
+    *    Typed properties override this to invoke valueChanged as well.
+    */
+    virtual void notifyChanged();
+
+    /**
+    *  @brief
+    *    Record a value change in the current batch update
+    *
+    *  @return
+    *    'true' if the property is part of a batch update and must not notify now, else 'false'
+    */
+    bool deferNotification();
+
+
+protected:
+    std::string   m_name;           ///< Property name
+    VariantMap    m_options;        ///< List of options
+    BatchUpdate * m_batch;          ///< Batch update the property is part of (can be null)
+    bool          m_changedInBatch; ///< 'true' if the property has been changed during the current batch update
 };
 
 
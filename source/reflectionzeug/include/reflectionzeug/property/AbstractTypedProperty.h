@@ -135,6 +135,11 @@ public:
     virtual bool fromVariant(const Variant & value) override;
 
 
+protected:
+    // Virtual AbstractProperty interface
+    virtual void notifyChanged() override;
+
+
 protected:
     std::unique_ptr<Accessor<Type>> m_accessor; ///< Accessor to get/set the value
 };
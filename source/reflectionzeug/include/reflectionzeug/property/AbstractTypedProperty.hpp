@@ -80,10 +80,23 @@ template <typename Type>
 void AbstractTypedProperty<Type>::setValue(const Type & value)
 {
     m_accessor->setValue(value);
+
+    // Notify later if the property is part of a batch update
+    if (this->deferNotification()) {
+        return;
+    }
+
     this->valueChanged(value);
     this->changed();
 }
 
+template <typename Type>
+void AbstractTypedProperty<Type>::notifyChanged()
+{
+    this->valueChanged(this->value());
+    this->changed();
+}
+
 template <typename Type>
 const std::type_info & AbstractTypedProperty<Type>::type() const
 {
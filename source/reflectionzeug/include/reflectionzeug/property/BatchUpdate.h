@@ -0,0 +1,94 @@
+#pragma once
+
+
+#include <vector>
+
+#include <reflectionzeug/reflectionzeug_api.h>
+
+
+namespace reflectionzeug
+{
+
+
+class AbstractProperty;
+class PropertyGroup;
+
+
+/**
+*  @brief
+*    Scope that coalesces change notifications of a property group
+*
+*    While a batch update exists, value changes of the properties in the group
+*    (including nested groups and array elements) do not invoke valueChanged and
+*    changed immediately. Instead, each changed property is recorded once and,
+*    when the batch update is destroyed, notified once in the order of its first
+*    change. Afterwards, PropertyGroup::valuesChanged is invoked with the complete
+*    list of changed properties, so that views can update in a single pass.
+*
+*    Nested batch updates are allowed; properties that are already part of
+*    a batch update stay with the outermost one. Properties added to the group
+*    after the batch update has been created are not part of it.
+*
+*  @code{.cpp}
+*
+*    {
+*        PropertyGroup::BatchUpdate batch(group);
+*        group.setValue<int>("width", 1920);
+*        group.setValue<int>("height", 1080);
+*    } // width and height notify here, followed by group.valuesChanged
+*
+*  @endcode
+*
+*  @remarks
+*    A batch update must not outlive its group.
+*/
+class REFLECTIONZEUG_API BatchUpdate
+{
+    friend class AbstractProperty;
+
+
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] group
+    *    Property group whose notifications are coalesced
+    */
+    explicit BatchUpdate(PropertyGroup & group);
+
+    /**
+    *  @brief
+    *    Destructor
+    *
+    *    Notifies all properties that have been changed during the batch update
+    */
+    ~BatchUpdate();
+
+    BatchUpdate(const BatchUpdate &) = delete;
+    BatchUpdate & operator=(const BatchUpdate &) = delete;
+
+    /**
+    *  @brief
+    *    Get properties that have been changed so far
+    *
+    *  @return
+    *    Changed properties, in order of their first change
+    */
+    const std::vector<AbstractProperty *> & changes() const;
+
+
+protected:
+    void claim(AbstractProperty & property);
+    void addChange(AbstractProperty * property);
+    void forget(AbstractProperty * property);
+
+
+protected:
+    PropertyGroup                   & m_group;      ///< Group whose notifications are coalesced
+    std::vector<AbstractProperty *>   m_properties; ///< Properties claimed by this batch update
+    std::vector<AbstractProperty *>   m_changes;    ///< Changed properties, in order of their first change
+};
+
+
+} // namespace reflectionzeug
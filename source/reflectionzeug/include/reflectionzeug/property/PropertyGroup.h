@@ -7,6 +7,7 @@
 
 #include <reflectionzeug/property/AbstractProperty.h>
 #include <reflectionzeug/property/AbstractCollection.h>
+#include <reflectionzeug/property/BatchUpdate.h>
 
 
 namespace reflectionzeug
@@ -30,6 +31,13 @@ class AbstractValueProperty;
 class REFLECTIONZEUG_API PropertyGroup : public AbstractCollection,
                                          public AbstractProperty
 {
+    friend class reflectionzeug::BatchUpdate;
+
+
+public:
+    using BatchUpdate = reflectionzeug::BatchUpdate;            ///< Scope that coalesces change notifications of the group
+
+
 public:
     static const char s_separator;                              ///< Separator for property hierarchies (".", e.g., "group.subgroup.value")
 
@@ -39,6 +47,7 @@ public:
     signalzeug::Signal<size_t, AbstractProperty *> afterAdd;    ///< Called, after a property is added to the group
     signalzeug::Signal<size_t> beforeRemove;                    ///< Called, before a property is removed from the group
     signalzeug::Signal<size_t> afterRemove;                     ///< Called, after a property is removed from the group
+    signalzeug::Signal<const std::vector<AbstractProperty *> &> valuesChanged; ///< Called after a batch update with all changed properties, in order of their first change
 
 
 public:
@@ -105,6 +114,18 @@ public:
     *    'true' if property exists, else 'false'
     */
     bool propertyExists(const std::string & name) const;
+
+    /**
+    *  @brief
+    *    Check if a batch update of the group is notifying its changed properties
+    *
+    *    Views can use this to ignore the individual changed signals
+    *    and handle the aggregated valuesChanged signal instead.
+    *
+    *  @return
+    *    'true' if the changed properties of a batch update are being notified, else 'false'
+    */
+    bool isNotifyingBatch() const;
     //@}
 
     //@{
@@ -325,6 +346,7 @@ protected:
     std::vector<AbstractProperty *>                     m_properties;       ///< List of properties in the group
     std::unordered_map<std::string, AbstractProperty *> m_propertiesMap;    ///< Map of names and properties
     bool                                                m_ownsProperties;   ///< If 'true', the group properties are deleted on destruction
+    size_t                                              m_notifyingBatch;   ///< Number of batch updates of the group that are notifying
 };
 
 
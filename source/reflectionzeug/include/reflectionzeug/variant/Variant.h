@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <typeinfo>
 
 #include <reflectionzeug/reflectionzeug_api.h>
 
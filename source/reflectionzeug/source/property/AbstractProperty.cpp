@@ -4,6 +4,11 @@
 #include <reflectionzeug/property/AbstractValueProperty.h>
 #include <reflectionzeug/property/AbstractCollection.h>
 #include <reflectionzeug/property/PropertyGroup.h>
+#include <reflectionzeug/property/BatchUpdate.h>
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+#include <signalzeug/Instrumentation.h>
+#endif
 
 
 namespace reflectionzeug
@@ -15,11 +20,21 @@ const std::string AbstractProperty::s_nameRegexString("[a-zA-Z_]+\\w*");
 
 AbstractProperty::AbstractProperty(const std::string & name)
 : m_name(name)
+, m_batch(nullptr)
+, m_changedInBatch(false)
 {
+#ifdef SIGNALZEUG_INSTRUMENTATION
+    // Make property change cascades identifiable in the signal statistics
+    signalzeug::Instrumentation::instance().setName(&changed, m_name + ".changed");
+#endif
 }
 
 AbstractProperty::~AbstractProperty()
 {
+    // Make sure the batch update does not notify a deleted property
+    if (m_batch) {
+        m_batch->forget(this);
+    }
 }
 
 bool AbstractProperty::hasName() const
@@ -124,5 +139,20 @@ bool AbstractProperty::removeOption(const std::string & key)
     return true;
 }
 
+void AbstractProperty::notifyChanged()
+{
+    changed();
+}
+
+bool AbstractProperty::deferNotification()
+{
+    if (!m_batch) {
+        return false;
+    }
+
+    m_batch->addChange(this);
+    return true;
+}
+
 
 } // namespace reflectionzeug
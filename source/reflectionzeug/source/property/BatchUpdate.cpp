@@ -0,0 +1,116 @@
+
+#include <reflectionzeug/property/BatchUpdate.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <reflectionzeug/property/AbstractProperty.h>
+#include <reflectionzeug/property/AbstractCollection.h>
+#include <reflectionzeug/property/PropertyGroup.h>
+
+
+namespace reflectionzeug
+{
+
+
+BatchUpdate::BatchUpdate(PropertyGroup & group)
+: m_group(group)
+{
+    // Claim all properties of the group that are not part of another batch update
+    group.forEach([this] (AbstractProperty & property)
+    {
+        claim(property);
+    });
+}
+
+BatchUpdate::~BatchUpdate()
+{
+    // Notify changed properties; changes made by the notified slots are
+    // appended and notified in the same pass
+    ++m_group.m_notifyingBatch;
+
+    for (size_t i = 0; i < m_changes.size(); ++i)
+    {
+        AbstractProperty * property = m_changes[i];
+
+        // Skip properties that have been deleted
+        if (!property) {
+            continue;
+        }
+
+        property->m_changedInBatch = false;
+        property->notifyChanged();
+    }
+
+    --m_group.m_notifyingBatch;
+
+    // Release properties
+    for (AbstractProperty * property : m_properties)
+    {
+        if (property) {
+            property->m_batch = nullptr;
+            property->m_changedInBatch = false;
+        }
+    }
+
+    // Invoke callback with every changed property exactly once
+    std::vector<AbstractProperty *> changes;
+    std::unordered_set<AbstractProperty *> notified;
+
+    for (AbstractProperty * property : m_changes)
+    {
+        if (property && notified.insert(property).second) {
+            changes.push_back(property);
+        }
+    }
+
+    if (!changes.empty()) {
+        m_group.valuesChanged(changes);
+    }
+}
+
+const std::vector<AbstractProperty *> & BatchUpdate::changes() const
+{
+    return m_changes;
+}
+
+void BatchUpdate::claim(AbstractProperty & property)
+{
+    // Properties of an enclosing batch update stay with it
+    if (property.m_batch) {
+        return;
+    }
+
+    property.m_batch = this;
+    m_properties.push_back(&property);
+
+    // Claim sub-properties (groups and array elements)
+    AbstractCollection * collection = property.asCollection();
+    if (collection) {
+        collection->forEach([this] (AbstractProperty & subProperty)
+        {
+            claim(subProperty);
+        });
+    }
+}
+
+void BatchUpdate::addChange(AbstractProperty * property)
+{
+    // Record only the first change of each property
+    if (property->m_changedInBatch) {
+        return;
+    }
+
+    property->m_changedInBatch = true;
+    m_changes.push_back(property);
+}
+
+void BatchUpdate::forget(AbstractProperty * property)
+{
+    // Entries are cleared rather than erased, as the destructor may be iterating
+    std::replace(m_properties.begin(), m_properties.end(), property, static_cast<AbstractProperty *>(nullptr));
+    std::replace(m_changes.begin(), m_changes.end(), property, static_cast<AbstractProperty *>(nullptr));
+}
+
+
+} // namespace reflectionzeug
@@ -21,12 +21,14 @@ const char PropertyGroup::s_separator('.');
 PropertyGroup::PropertyGroup()
 : AbstractProperty("")
 , m_ownsProperties(true)
+, m_notifyingBatch(0)
 {
 }
 
 PropertyGroup::PropertyGroup(const std::string & name)
 : AbstractProperty(name)
 , m_ownsProperties(true)
+, m_notifyingBatch(0)
 {
 }
 
@@ -89,6 +91,11 @@ bool PropertyGroup::propertyExists(const std::string & name) const
     return m_propertiesMap.find(name) != m_propertiesMap.end();
 }
 
+bool PropertyGroup::isNotifyingBatch() const
+{
+    return m_notifyingBatch > 0;
+}
+
 AbstractProperty * PropertyGroup::property(const std::string & path)
 {
     std::vector<std::string> splittedPath = stringzeug::split(path, s_separator);
@@ -310,6 +317,9 @@ bool PropertyGroup::fromVariant(const Variant & value)
         return false;
     }
 
+    // Notify once after all values have been set
+    BatchUpdate batch(*this);
+
     // Get all values from variant map
     for (auto it : *value.asMap()) {
         // Get name and value
@@ -1,6 +1,9 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 #include <signalzeug/signalzeug_api.h>
 #include <signalzeug/Connection.h>
@@ -15,18 +18,38 @@ class SIGNALZEUG_API AbstractSignal
 
 public:
 	AbstractSignal();
+	AbstractSignal(const AbstractSignal & other);
 	virtual ~AbstractSignal();
 
+	AbstractSignal & operator=(const AbstractSignal & other);
+
 protected:
+	// Entry of the handle table; freed entries are reused with an incremented
+	// generation, so that ids of disconnected slots never match again
+	struct Handle
+	{
+		std::uint32_t generation;
+		bool connected;
+		size_t position; // Slot position, as maintained by the derived signal, or next free handle
+	};
+
 	Connection createConnection() const;
-	void disconnect(Connection & connection) const;
+	virtual void disconnect(Connection & connection) const;
+
+	bool isConnected(Connection::Id id) const;
+	size_t position(Connection::Id id) const;
+	void setPosition(Connection::Id id, size_t position) const;
 
 protected:
+	// Called for connected ids only, before the handle is released
 	virtual void disconnectId(Connection::Id id) const = 0;
 
 protected:
-	mutable Connection::Id m_nextId;
-	mutable std::unordered_map<Connection::Id, Connection> m_connections;
+	// Observed by the connections; created on first connect and
+	// released on destruction, which expires all connections at once
+	mutable std::shared_ptr<const AbstractSignal> m_self;
+	mutable std::vector<Handle> m_handles;
+	mutable size_t m_freeHandle;
 };
 
 } // namespace signalzeug
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 #include <signalzeug/signalzeug_api.h>
@@ -10,42 +11,44 @@ namespace signalzeug
 
 class AbstractSignal;
 
+/**
+*  @brief
+*    Handle of a slot connected to a signal
+*
+*    A connection refers to its slot by a generational index into the handle table of the
+*    signal and observes the signal through a weak reference, so creating, copying and
+*    dropping connections does not allocate. Copies refer to the same slot; once any of them
+*    has disconnected it, disconnecting the others has no effect.
+*/
 class SIGNALZEUG_API Connection
 {
 	friend class AbstractSignal;
 
 public:
-    typedef unsigned int Id;
-
-
-protected:
-    struct State
-	{
-		const AbstractSignal * signal;
-		Id id;
-	};
+	// Index into the handle table of the signal (lower 32 bits) and generation (upper 32 bits);
+	// 64 bits wide since the handle table was introduced, formerly an unsigned int
+	typedef std::uint64_t Id;
 
 public:
 	Connection();
-    Connection(const Connection & other);
-    Connection(Connection && other);
+	Connection(const Connection & other);
+	Connection(Connection && other);
 
-    Connection & operator=(const Connection & other);
-    Connection & operator=(Connection && other);
+	Connection & operator=(const Connection & other);
+	Connection & operator=(Connection && other);
 
 	void disconnect();
 
 	Id id() const;
 
 protected:
-    Connection(
-        const AbstractSignal * signal
-    ,   Id id);
-
-	void detach();
+	Connection(
+		const std::shared_ptr<const AbstractSignal> & signal
+	,   Id id);
 
 protected:
-	std::shared_ptr<State> m_state;
+	std::weak_ptr<const AbstractSignal> m_signal;
+	Id m_id;
 };
 
 } // namespace signalzeug
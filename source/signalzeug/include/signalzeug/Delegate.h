@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+
+namespace signalzeug
+{
+
+template <typename Signature>
+class Delegate;
+
+/**
+*  @brief
+*    Type-erased callable with guaranteed inline storage
+*
+*    Like std::function, but every callable of up to BufferSize bytes that can be moved
+*    without throwing is stored inside the delegate itself; this includes lambdas capturing
+*    up to four pointers. The buffer is large enough for a std::function, which is stored
+*    inline if the standard library moves it without throwing. Larger callables are stored
+*    on the heap.
+*
+*    Member functions are bound directly to their object, without a wrapping lambda:
+*
+*    \code{.cpp}
+*        Delegate<void(int)> delegate(&window, &Window::setWidth);
+*        delegate(1920); // calls window.setWidth(1920)
+*    \endcode
+*
+*    Calling an empty delegate is undefined.
+*/
+template <typename Result, typename... Arguments>
+class Delegate<Result(Arguments...)>
+{
+public:
+	static const size_t BufferSize = sizeof(std::function<Result(Arguments...)>) > 4 * sizeof(void *)
+		? sizeof(std::function<Result(Arguments...)>) : 4 * sizeof(void *);
+
+protected:
+	// Callables other than Delegate that can be called with Arguments and return Result
+	template <typename Callable, typename = void>
+	struct IsCallable : std::false_type
+	{
+	};
+
+	template <typename Callable>
+	struct IsCallable<Callable, typename std::enable_if<
+		!std::is_same<typename std::decay<Callable>::type, Delegate>::value
+		&& (std::is_void<Result>::value || std::is_convertible<
+			decltype(std::declval<typename std::decay<Callable>::type &>()(std::declval<Arguments>()...)), Result>::value)
+		>::type> : std::true_type
+	{
+	};
+
+public:
+	Delegate();
+	Delegate(std::nullptr_t);
+
+	template <typename Callable, typename = typename std::enable_if<IsCallable<Callable>::value>::type>
+	Delegate(Callable && callable);
+
+	template <class T>
+	Delegate(T * object, Result (T::*method)(Arguments...));
+
+	template <class T>
+	Delegate(const T * object, Result (T::*method)(Arguments...) const);
+
+	Delegate(const Delegate & other);
+	Delegate(Delegate && other);
+	~Delegate();
+
+	Delegate & operator=(const Delegate & other);
+	Delegate & operator=(Delegate && other);
+
+	Result operator()(Arguments... arguments) const;
+
+	explicit operator bool() const;
+
+	/**
+	*  @brief
+	*    Check if the callable is stored inside the delegate
+	*
+	*  @return
+	*    'true' if the callable is stored inline or the delegate is empty, 'false' if it is stored on the heap
+	*/
+	bool isInline() const;
+
+protected:
+	enum class Operation
+	{
+		Copy,
+		Move,
+		Destroy
+	};
+
+	// Callables with a stricter alignment than pointers are stored on the heap
+	typedef typename std::aligned_storage<BufferSize, alignof(void *)>::type Storage;
+	static_assert(sizeof(std::function<Result(Arguments...)>) <= sizeof(Storage)
+		&& alignof(std::function<Result(Arguments...)>) <= alignof(Storage),
+		"std::function does not fit into the delegate");
+	typedef Result (*Invoke)(Storage & storage, Arguments &&... arguments);
+	// Copies or moves the callable from source to target, or destroys the callable in target
+	typedef void (*Manage)(Operation operation, Storage & target, Storage * source);
+
+	template <typename Callable>
+	struct Fits
+	{
+		static const bool value = sizeof(Callable) <= BufferSize
+			&& alignof(Callable) <= alignof(Storage)
+			&& std::is_nothrow_move_constructible<Callable>::value;
+	};
+
+	template <class T, typename Method>
+	struct BoundMethod
+	{
+		T * object;
+		Method method;
+	};
+
+	template <typename Callable>
+	static Result invokeInline(Storage & storage, Arguments &&... arguments);
+	template <typename Callable>
+	static Result invokeHeap(Storage & storage, Arguments &&... arguments);
+	template <class T, typename Method>
+	static Result invokeMethod(Storage & storage, Arguments &&... arguments);
+
+	template <typename Callable>
+	static void manageInline(Operation operation, Storage & target, Storage * source);
+	template <typename Callable>
+	static void manageHeap(Operation operation, Storage & target, Storage * source);
+
+	template <typename Callable>
+	void store(Callable && callable, std::true_type fits);
+	template <typename Callable>
+	void store(Callable && callable, std::false_type fits);
+
+	void reset();
+
+protected:
+	mutable Storage m_storage;
+	Invoke m_invoke;
+	Manage m_manage; // nullptr for trivially copyable inline callables, such as bound methods
+	bool m_inline;
+};
+
+} // namespace signalzeug
+
+#include <signalzeug/Delegate.hpp>
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <signalzeug/Delegate.h>
+
+namespace signalzeug
+{
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)>::Delegate()
+: m_invoke(nullptr)
+, m_manage(nullptr)
+, m_inline(true)
+{
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)>::Delegate(std::nullptr_t)
+: Delegate()
+{
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable, typename>
+Delegate<Result(Arguments...)>::Delegate(Callable && callable)
+: Delegate()
+{
+	typedef typename std::decay<Callable>::type Stored;
+
+	store(std::forward<Callable>(callable), std::integral_constant<bool, Fits<Stored>::value>());
+}
+
+template <typename Result, typename... Arguments>
+template <class T>
+Delegate<Result(Arguments...)>::Delegate(T * object, Result (T::*method)(Arguments...))
+: Delegate()
+{
+	typedef BoundMethod<T, Result (T::*)(Arguments...)> Bound;
+	static_assert(sizeof(Bound) <= BufferSize, "Bound method does not fit into the delegate");
+
+	new (&m_storage) Bound{ object, method };
+	m_invoke = &invokeMethod<T, Result (T::*)(Arguments...)>;
+}
+
+template <typename Result, typename... Arguments>
+template <class T>
+Delegate<Result(Arguments...)>::Delegate(const T * object, Result (T::*method)(Arguments...) const)
+: Delegate()
+{
+	typedef BoundMethod<const T, Result (T::*)(Arguments...) const> Bound;
+	static_assert(sizeof(Bound) <= BufferSize, "Bound method does not fit into the delegate");
+
+	new (&m_storage) Bound{ object, method };
+	m_invoke = &invokeMethod<const T, Result (T::*)(Arguments...) const>;
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)>::Delegate(const Delegate & other)
+: m_invoke(other.m_invoke)
+, m_manage(other.m_manage)
+, m_inline(other.m_inline)
+{
+	if (m_manage)
+		m_manage(Operation::Copy, m_storage, &other.m_storage);
+	else
+		std::memcpy(&m_storage, &other.m_storage, sizeof(Storage));
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)>::Delegate(Delegate && other)
+: m_invoke(other.m_invoke)
+, m_manage(other.m_manage)
+, m_inline(other.m_inline)
+{
+	if (m_manage)
+		m_manage(Operation::Move, m_storage, &other.m_storage);
+	else
+		std::memcpy(&m_storage, &other.m_storage, sizeof(Storage));
+
+	other.reset();
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)>::~Delegate()
+{
+	reset();
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)> & Delegate<Result(Arguments...)>::operator=(const Delegate & other)
+{
+	if (this != &other)
+	{
+		Delegate copy(other);
+		*this = std::move(copy);
+	}
+
+	return *this;
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)> & Delegate<Result(Arguments...)>::operator=(Delegate && other)
+{
+	if (this != &other)
+	{
+		reset();
+
+		m_invoke = other.m_invoke;
+		m_manage = other.m_manage;
+		m_inline = other.m_inline;
+
+		if (m_manage)
+			m_manage(Operation::Move, m_storage, &other.m_storage);
+		else
+			std::memcpy(&m_storage, &other.m_storage, sizeof(Storage));
+
+		other.reset();
+	}
+
+	return *this;
+}
+
+template <typename Result, typename... Arguments>
+Result Delegate<Result(Arguments...)>::operator()(Arguments... arguments) const
+{
+	assert(m_invoke);
+
+	return m_invoke(m_storage, std::forward<Arguments>(arguments)...);
+}
+
+template <typename Result, typename... Arguments>
+Delegate<Result(Arguments...)>::operator bool() const
+{
+	return m_invoke != nullptr;
+}
+
+template <typename Result, typename... Arguments>
+bool Delegate<Result(Arguments...)>::isInline() const
+{
+	return m_inline;
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable>
+Result Delegate<Result(Arguments...)>::invokeInline(Storage & storage, Arguments &&... arguments)
+{
+	return (*reinterpret_cast<Callable *>(&storage))(std::forward<Arguments>(arguments)...);
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable>
+Result Delegate<Result(Arguments...)>::invokeHeap(Storage & storage, Arguments &&... arguments)
+{
+	return (**reinterpret_cast<Callable **>(&storage))(std::forward<Arguments>(arguments)...);
+}
+
+template <typename Result, typename... Arguments>
+template <class T, typename Method>
+Result Delegate<Result(Arguments...)>::invokeMethod(Storage & storage, Arguments &&... arguments)
+{
+	const BoundMethod<T, Method> & bound = *reinterpret_cast<BoundMethod<T, Method> *>(&storage);
+
+	return (bound.object->*bound.method)(std::forward<Arguments>(arguments)...);
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable>
+void Delegate<Result(Arguments...)>::manageInline(Operation operation, Storage & target, Storage * source)
+{
+	switch (operation)
+	{
+	case Operation::Copy:
+		new (&target) Callable(*reinterpret_cast<const Callable *>(source));
+		break;
+
+	case Operation::Move:
+		new (&target) Callable(std::move(*reinterpret_cast<Callable *>(source)));
+		break;
+
+	case Operation::Destroy:
+	default:
+		reinterpret_cast<Callable *>(&target)->~Callable();
+		break;
+	}
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable>
+void Delegate<Result(Arguments...)>::manageHeap(Operation operation, Storage & target, Storage * source)
+{
+	switch (operation)
+	{
+	case Operation::Copy:
+		new (&target) Callable *(new Callable(**reinterpret_cast<const Callable * const *>(source)));
+		break;
+
+	case Operation::Move:
+		// The pointer is taken over, the source is reset without destroying the callable
+		new (&target) Callable *(*reinterpret_cast<Callable **>(source));
+		*reinterpret_cast<Callable **>(source) = nullptr;
+		break;
+
+	case Operation::Destroy:
+	default:
+		delete *reinterpret_cast<Callable **>(&target);
+		break;
+	}
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable>
+void Delegate<Result(Arguments...)>::store(Callable && callable, std::true_type /*fits*/)
+{
+	typedef typename std::decay<Callable>::type Stored;
+
+	new (&m_storage) Stored(std::forward<Callable>(callable));
+	m_invoke = &invokeInline<Stored>;
+	// Trivially copyable callables, e.g., lambdas capturing references, are copied bytewise
+	m_manage = std::is_trivially_copyable<Stored>::value ? nullptr : &manageInline<Stored>;
+	m_inline = true;
+}
+
+template <typename Result, typename... Arguments>
+template <typename Callable>
+void Delegate<Result(Arguments...)>::store(Callable && callable, std::false_type /*fits*/)
+{
+	typedef typename std::decay<Callable>::type Stored;
+
+	new (&m_storage) Stored *(new Stored(std::forward<Callable>(callable)));
+	m_invoke = &invokeHeap<Stored>;
+	m_manage = &manageHeap<Stored>;
+	m_inline = false;
+}
+
+template <typename Result, typename... Arguments>
+void Delegate<Result(Arguments...)>::reset()
+{
+	if (m_manage)
+		m_manage(Operation::Destroy, m_storage, nullptr);
+
+	m_invoke = nullptr;
+	m_manage = nullptr;
+	m_inline = true;
+}
+
+} // namespace signalzeug
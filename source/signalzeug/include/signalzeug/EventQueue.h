@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <signalzeug/signalzeug_api.h>
+
+
+namespace signalzeug
+{
+
+/**
+*  @brief
+*    Delivery of signals connected to an EventQueue
+*/
+enum class Delivery
+{
+	Queued,   ///< Every emission is delivered
+	Coalesced ///< Emissions between two calls of EventQueue::process collapse into one delivery with the latest arguments
+};
+
+/**
+*  @brief
+*    Queue of events that are executed on the thread that pumps the queue
+*
+*    Events may be posted from any thread. A signal connected to a queue (see Signal::connect)
+*    copies its arguments into an event on fire and returns immediately; the slot is
+*    called with these arguments once the target thread calls process():
+*
+*    \code{.cpp}
+*        EventQueue uiQueue;
+*        worker.progress.connect(uiQueue, [&bar](int percent) { bar.setValue(percent); }, Delivery::Coalesced);
+*
+*        // UI thread
+*        while (running)
+*        {
+*            uiQueue.wait(std::chrono::milliseconds(16));
+*            uiQueue.process();
+*        }
+*    \endcode
+*
+*    Events that are pending when their slot is disconnected are dropped; for a ThreadSafeSignal,
+*    once no fire of the signal is running anymore. The queue has to outlive the connections to it.
+*/
+class SIGNALZEUG_API EventQueue
+{
+public:
+	typedef std::function<void()> Event;
+
+public:
+	EventQueue();
+	~EventQueue();
+
+	EventQueue(const EventQueue &) = delete;
+	EventQueue & operator=(const EventQueue &) = delete;
+
+	void post(Event event);
+
+	/**
+	*  @brief
+	*    Posts an event that replaces a pending event with the same key (keeping its position)
+	*/
+	void post(const void * key, Event event);
+
+	/**
+	*  @brief
+	*    Executes all events posted so far on the calling thread
+	*
+	*    Events posted while processing are executed by the next call.
+	*    Returns the number of executed events.
+	*/
+	size_t process();
+
+	/**
+	*  @brief
+	*    Blocks until an event is pending or the timeout expired; returns true if an event is pending
+	*/
+	bool wait(std::chrono::milliseconds timeout);
+
+	bool empty() const;
+
+	/**
+	*  @brief
+	*    Returns a callback that posts callback(arguments...) to this queue
+	*
+	*    The arguments are copied into the event; the returned callback is what
+	*    Signal::connect(EventQueue &, ...) connects to the signal. Pending events are
+	*    dropped once the returned callback is destroyed; copies post events of their own.
+	*/
+	template <typename... Arguments>
+	std::function<void(Arguments...)> queued(std::function<void(Arguments...)> callback, Delivery delivery = Delivery::Queued);
+
+protected:
+	struct Entry
+	{
+		const void * key; // nullptr for events that are never coalesced
+		Event event;
+	};
+
+protected:
+	mutable std::mutex m_mutex;
+	std::condition_variable m_posted;
+	std::vector<Entry> m_events;
+	std::unordered_map<const void *, size_t> m_coalesced; // key to index in m_events
+};
+
+} // namespace signalzeug
+
+#include <signalzeug/EventQueue.hpp>
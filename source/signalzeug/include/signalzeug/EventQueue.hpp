@@ -0,0 +1,139 @@
+#pragma once
+
+#include <signalzeug/EventQueue.h>
+
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace signalzeug
+{
+
+namespace detail
+{
+
+template <size_t... Indices>
+struct IndexSequence
+{
+};
+
+template <size_t N, size_t... Indices>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...>
+{
+};
+
+template <size_t... Indices>
+struct MakeIndexSequence<0, Indices...>
+{
+	typedef IndexSequence<Indices...> type;
+};
+
+// Shared by the callback connected to the signal and all events it posted
+template <typename... Arguments>
+struct QueuedSlot
+{
+	QueuedSlot(std::function<void(Arguments...)> callback)
+	: callback(std::move(callback))
+	, connected(true)
+	{
+	}
+
+	std::function<void(Arguments...)> callback;
+	std::atomic<bool> connected;
+};
+
+// A single delivery; holds copies of the arguments of one fire
+template <typename... Arguments>
+class QueuedEvent
+{
+public:
+	typedef std::tuple<typename std::decay<Arguments>::type...> Values;
+
+	QueuedEvent(std::shared_ptr<QueuedSlot<Arguments...>> slot, Values && values)
+	: m_slot(std::move(slot))
+	, m_values(std::move(values))
+	{
+	}
+
+	void operator()()
+	{
+		if (m_slot->connected)
+			call(typename MakeIndexSequence<sizeof...(Arguments)>::type());
+	}
+
+protected:
+	template <size_t... Indices>
+	void call(IndexSequence<Indices...>)
+	{
+		m_slot->callback(std::get<Indices>(m_values)...);
+	}
+
+protected:
+	std::shared_ptr<QueuedSlot<Arguments...>> m_slot;
+	Values m_values;
+};
+
+// Callback connected to the signal; posts an event per call. Each copy, e.g., of a copied
+// signal, is a slot of its own, and destroying it, i.e., disconnecting the slot, drops the
+// events it posted that are still pending
+template <typename... Arguments>
+class QueuedCallback
+{
+public:
+	typedef QueuedSlot<Arguments...> Slot;
+	typedef QueuedEvent<Arguments...> Event;
+
+	QueuedCallback(EventQueue & queue, std::function<void(Arguments...)> callback, Delivery delivery)
+	: m_queue(&queue)
+	, m_slot(std::make_shared<Slot>(std::move(callback)))
+	, m_delivery(delivery)
+	{
+	}
+
+	QueuedCallback(const QueuedCallback & other)
+	: m_queue(other.m_queue)
+	, m_slot(std::make_shared<Slot>(other.m_slot->callback))
+	, m_delivery(other.m_delivery)
+	{
+	}
+
+	QueuedCallback(QueuedCallback && other)
+	: m_queue(other.m_queue)
+	, m_slot(std::move(other.m_slot))
+	, m_delivery(other.m_delivery)
+	{
+	}
+
+	~QueuedCallback()
+	{
+		if (m_slot)
+			m_slot->connected = false;
+	}
+
+	QueuedCallback & operator=(const QueuedCallback &) = delete;
+	QueuedCallback & operator=(QueuedCallback &&) = delete;
+
+	void operator()(Arguments... arguments) const
+	{
+		const void * key = m_delivery == Delivery::Coalesced ? m_slot.get() : nullptr;
+
+		m_queue->post(key, Event(m_slot, typename Event::Values(std::move(arguments)...)));
+	}
+
+protected:
+	EventQueue * m_queue;
+	std::shared_ptr<Slot> m_slot; // nullptr if moved from
+	Delivery m_delivery;
+};
+
+} // namespace detail
+
+template <typename... Arguments>
+std::function<void(Arguments...)> EventQueue::queued(std::function<void(Arguments...)> callback, Delivery delivery)
+{
+	return detail::QueuedCallback<Arguments...>(*this, std::move(callback), delivery);
+}
+
+} // namespace signalzeug
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <signalzeug/signalzeug_api.h>
+#include <signalzeug/Connection.h>
+
+
+namespace signalzeug
+{
+
+class AbstractSignal;
+
+/**
+*  @brief
+*    Statistics and traces of signal emissions
+*
+*    Signals only report to the instrumentation if signalzeug has been built with
+*    OPTION_BUILD_WITH_SIGNAL_INSTRUMENTATION, which defines SIGNALZEUG_INSTRUMENTATION.
+*    Otherwise, the hooks are compiled out of Signal::fire and ThreadSafeSignal::fire
+*    entirely, and all statistics stay empty.
+*
+*    When compiled in, recording starts disabled and is switched on at runtime:
+*
+*    \code{.cpp}
+*        auto & instrumentation = Instrumentation::instance();
+*        instrumentation.setName(&property->changed, "width.changed");
+*        instrumentation.setEnabled(true);
+*        instrumentation.setTracing(true);
+*
+*        renderFrame();
+*
+*        instrumentation.writeReport(std::cout);
+*
+*        std::ofstream trace("frame.json"); // open in chrome://tracing
+*        instrumentation.writeChromeTrace(trace);
+*    \endcode
+*
+*    Per signal, the number of fires, the number of slots called, the time spent in fire
+*    (including nested fires) and the maximum nesting depth of fires (e.g., signals
+*    forwarded with Signal::connect(Signal &)) are recorded. Per slot, the number of
+*    calls and the total and maximum call time are recorded.
+*/
+class SIGNALZEUG_API Instrumentation
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	struct SignalStatistics
+	{
+		std::string name;
+		size_t fires;
+		size_t slotCalls;
+		size_t maximumDepth;        ///< Maximum nesting level of fires (of any signal) this signal has been fired at; 1 if never fired by a slot
+		Clock::duration fireTime;   ///< Accumulated time in fire, including the slots
+	};
+
+	struct SlotStatistics
+	{
+		std::string signalName;
+		Connection::Id id;
+		size_t calls;
+		Clock::duration totalTime;
+		Clock::duration maximumTime;
+	};
+
+	/**
+	*  @brief
+	*    Records the fire of a signal while in scope
+	*/
+	class SIGNALZEUG_API FireScope
+	{
+	public:
+		FireScope(const AbstractSignal * signal);
+		~FireScope();
+
+		FireScope(const FireScope &) = delete;
+		FireScope & operator=(const FireScope &) = delete;
+
+	protected:
+		const AbstractSignal * m_signal; // nullptr if recording is disabled
+		Clock::time_point m_start;
+	};
+
+	/**
+	*  @brief
+	*    Records the call of a slot while in scope
+	*/
+	class SIGNALZEUG_API SlotScope
+	{
+	public:
+		SlotScope(const AbstractSignal * signal, Connection::Id id);
+		~SlotScope();
+
+		SlotScope(const SlotScope &) = delete;
+		SlotScope & operator=(const SlotScope &) = delete;
+
+	protected:
+		const AbstractSignal * m_signal; // nullptr if recording is disabled
+		Connection::Id m_id;
+		Clock::time_point m_start;
+	};
+
+public:
+	static Instrumentation & instance();
+
+	/**
+	*  @brief
+	*    Check if the signals have been compiled with instrumentation
+	*
+	*  @return
+	*    'true' if SIGNALZEUG_INSTRUMENTATION has been defined, else 'false'
+	*/
+	static bool isCompiledIn();
+
+	bool isEnabled() const;
+	void setEnabled(bool enabled);
+
+	bool isTracing() const;
+
+	/**
+	*  @brief
+	*    Record every fire and slot call as a trace event
+	*
+	*  @param[in] tracing
+	*    'true' to record trace events while enabled, else 'false'
+	*  @param[in] maximumEvents
+	*    Number of events after which recording of trace events stops
+	*/
+	void setTracing(bool tracing, size_t maximumEvents = 1000000);
+
+	/**
+	*  @brief
+	*    Set the name a signal is reported with
+	*
+	*    Unnamed signals are reported by address.
+	*/
+	void setName(const AbstractSignal * signal, const std::string & name);
+
+	/**
+	*  @brief
+	*    Discard all statistics and trace events; names are kept
+	*/
+	void reset();
+
+	/**
+	*  @brief
+	*    Get statistics of all signals that have been fired, including destroyed signals
+	*
+	*  @return
+	*    Statistics, sorted by descending fire time
+	*/
+	std::vector<SignalStatistics> signalStatistics() const;
+
+	/**
+	*  @brief
+	*    Get statistics of all slots that have been called, including slots of destroyed signals
+	*
+	*  @return
+	*    Statistics, sorted by descending total time
+	*/
+	std::vector<SlotStatistics> slotStatistics() const;
+
+	/**
+	*  @brief
+	*    Get the maximum number of nested fires
+	*/
+	size_t maximumDepth() const;
+
+	/**
+	*  @brief
+	*    Write a human readable summary of the hottest signals and slots
+	*
+	*  @param[in] stream
+	*    Output stream
+	*  @param[in] count
+	*    Maximum number of signals and slots listed
+	*/
+	void writeReport(std::ostream & stream, size_t count = 20) const;
+
+	/**
+	*  @brief
+	*    Write the trace events in the Chrome trace event format (JSON)
+	*
+	*    The result can be loaded in chrome://tracing or https://ui.perfetto.dev.
+	*/
+	void writeChromeTrace(std::ostream & stream) const;
+
+	/**
+	*  @brief
+	*    Detach the statistics of a signal that is being destroyed from its address
+	*
+	*    Called by ~AbstractSignal, so that the address can be reused by another signal.
+	*/
+	void retire(const AbstractSignal * signal);
+
+protected:
+	struct TraceEvent
+	{
+		size_t signal;
+		Connection::Id id; // 0 for fires
+		size_t thread;
+		Clock::time_point start;
+		Clock::duration duration;
+	};
+
+	Instrumentation();
+
+	void recordFire(const AbstractSignal * signal, Clock::time_point start, Clock::duration duration, size_t depth);
+	void recordSlot(const AbstractSignal * signal, Connection::Id id, Clock::time_point start, Clock::duration duration);
+
+	// Called with m_mutex locked
+	size_t indexOf(const AbstractSignal * signal);
+
+protected:
+	std::atomic<bool> m_enabled;
+	std::atomic<bool> m_tracing;
+
+	mutable std::mutex m_mutex;
+	size_t m_maximumEvents;
+	size_t m_maximumDepth;
+	Clock::time_point m_epoch;
+
+	// Names of live signals; kept apart from the statistics, so that naming
+	// signals that are never fired does not accumulate statistics
+	std::unordered_map<const AbstractSignal *, std::string> m_names;
+	// Index of each live signal into m_signals; destroyed signals are removed,
+	// while their statistics and trace events remain
+	std::unordered_map<const AbstractSignal *, size_t> m_indices;
+	std::vector<SignalStatistics> m_signals;
+	std::map<std::pair<size_t, Connection::Id>, SlotStatistics> m_slots;
+	std::vector<TraceEvent> m_events;
+};
+
+} // namespace signalzeug
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
-#include <unordered_map>
+#include <vector>
 
 #include <signalzeug/signalzeug_api.h>
 #include <signalzeug/AbstractSignal.h>
+#include <signalzeug/Delegate.h>
+#include <signalzeug/EventQueue.h>
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+#include <signalzeug/Instrumentation.h>
+#endif
 
 
 namespace signalzeug
@@ -14,7 +21,7 @@ template <typename... Arguments>
 class Signal : public AbstractSignal
 {
 public:
-	typedef std::function<void(Arguments...)> Callback;
+	typedef Delegate<void(Arguments...)> Callback;
 
 	Signal();
 
@@ -27,16 +34,42 @@ public:
     template <class T>
 	Connection connect(T * object, void (T::*method)(Arguments...)) const;
 
+	Connection connect(EventQueue & queue, Callback callback, Delivery delivery = Delivery::Queued) const;
+
 	void block();
 	void unblock();
 
 	Connection onFire(std::function<void()> callback) const;
 
 protected:
+	struct Slot
+	{
+		Connection::Id id; // 0 for disconnected slots (tombstones)
+		Callback callback;
+	};
+
+	// Position of the slot a running fire is calling; nested fires form a chain
+	struct Running
+	{
+		size_t index;
+		const Running * outer;
+	};
+
 	virtual void disconnectId(Connection::Id id) const override;
 
+	bool isRunning(size_t index) const;
+	void compact() const;
+
 protected:
-	mutable std::unordered_map<Connection::Id, Callback> m_callbacks;
+	// Slots in connection order; disconnected slots are removed lazily so that
+	// neither fire nor disconnect have to move callbacks around
+	mutable std::vector<Slot> m_slots;
+	// Slots connected during fire, appended after the outermost fire returns;
+	// positions beyond m_slots refer to these
+	mutable std::vector<Slot> m_pendingSlots;
+	mutable size_t m_tombstones;
+	size_t m_firing;
+	const Running * m_running; // innermost running fire, or nullptr
 	bool m_blocked;
 };
 
@@ -7,7 +7,10 @@ namespace signalzeug
 
 template <typename... Arguments>
 Signal<Arguments...>::Signal()
-: m_blocked(false)
+: m_tombstones(0)
+, m_firing(0)
+, m_running(nullptr)
+, m_blocked(false)
 {
 }
 
@@ -16,12 +19,36 @@ void Signal<Arguments...>::fire(Arguments... arguments)
 {
 	if (m_blocked)
 		return;
-	
-	for (auto & pair : m_callbacks)
+
+	++m_firing;
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+	Instrumentation::FireScope fireScope(this);
+#endif
+
+	// Slots connected by a callback are not called before the next fire; m_slots
+	// neither grows nor shrinks while firing, so callbacks are called in place
+	const size_t size = m_slots.size();
+
+	Running running{ 0, m_running };
+	m_running = &running;
+
+	for (size_t i = 0; i < size; ++i)
 	{
-		Callback callback = pair.second;
-		callback(arguments...);
+		if (m_slots[i].id == 0)
+			continue;
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+		Instrumentation::SlotScope slotScope(this, m_slots[i].id);
+#endif
+		running.index = i;
+		m_slots[i].callback(arguments...);
 	}
+
+	m_running = running.outer;
+
+	if (--m_firing == 0 && (!m_pendingSlots.empty() || m_tombstones > 0))
+		compact();
 }
 
 template <typename... Arguments>
@@ -34,7 +61,18 @@ template <typename... Arguments>
 Connection Signal<Arguments...>::connect(Callback callback) const
 {
 	Connection connection = createConnection();
-	m_callbacks[connection.id()] = callback;
+
+	if (m_firing > 0)
+	{
+		setPosition(connection.id(), m_slots.size() + m_pendingSlots.size());
+		m_pendingSlots.push_back(Slot{ connection.id(), std::move(callback) });
+	}
+	else
+	{
+		setPosition(connection.id(), m_slots.size());
+		m_slots.push_back(Slot{ connection.id(), std::move(callback) });
+	}
+
 	return connection;
 }
 
@@ -42,19 +80,19 @@ template <typename... Arguments>
 template <class T>
 Connection Signal<Arguments...>::connect(T * object, void (T::*method)(Arguments...)) const
 {
-	return connect([object, method](Arguments... arguments) 
-	{
-		(object->*method)(arguments...);
-	});
+	return connect(Callback(object, method));
 }
 
 template <typename... Arguments>
 Connection Signal<Arguments...>::connect(Signal& signal) const
 {
-	return connect([&signal](Arguments... arguments) 
-	{
-		signal.fire(arguments...);
-	});
+	return connect(Callback(&signal, &Signal::fire));
+}
+
+template <typename... Arguments>
+Connection Signal<Arguments...>::connect(EventQueue & queue, Callback callback, Delivery delivery) const
+{
+	return connect(queue.queued(std::function<void(Arguments...)>(std::move(callback)), delivery));
 }
 
 template <typename... Arguments>
@@ -81,7 +119,66 @@ void Signal<Arguments...>::unblock()
 template <typename... Arguments>
 void Signal<Arguments...>::disconnectId(Connection::Id id) const
 {
-	m_callbacks.erase(id);
+	const size_t index = position(id);
+
+	// The slot is only marked and removed on compaction, so that fire does not have to
+	// move callbacks around
+	Slot & slot = index < m_slots.size() ? m_slots[index] : m_pendingSlots[index - m_slots.size()];
+	slot.id = 0;
+	++m_tombstones;
+
+	// The callback is released right away (e.g., dropping its pending queued events),
+	// unless it is executing right now (e.g., disconnecting itself)
+	if (!isRunning(index))
+		slot.callback = Callback();
+
+	// Outside of fire, compact once at least half of the slots are tombstones
+	if (m_firing == 0 && m_tombstones * 2 >= m_slots.size())
+		compact();
+}
+
+template <typename... Arguments>
+bool Signal<Arguments...>::isRunning(size_t index) const
+{
+	for (const Running * running = m_running; running; running = running->outer)
+	{
+		if (running->index == index)
+			return true;
+	}
+
+	return false;
+}
+
+template <typename... Arguments>
+void Signal<Arguments...>::compact() const
+{
+	size_t size = 0;
+
+	for (size_t i = 0; i < m_slots.size(); ++i)
+	{
+		if (m_slots[i].id == 0)
+			continue;
+
+		if (i != size)
+			m_slots[size] = std::move(m_slots[i]);
+
+		setPosition(m_slots[size].id, size);
+		++size;
+	}
+
+	m_slots.erase(m_slots.begin() + size, m_slots.end());
+
+	for (auto & slot : m_pendingSlots)
+	{
+		if (slot.id == 0)
+			continue;
+
+		setPosition(slot.id, m_slots.size());
+		m_slots.push_back(std::move(slot));
+	}
+
+	m_pendingSlots.clear();
+	m_tombstones = 0;
 }
 
 } // namespace signalzeug
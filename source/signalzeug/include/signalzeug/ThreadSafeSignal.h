@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <signalzeug/signalzeug_api.h>
+#include <signalzeug/AbstractSignal.h>
+#include <signalzeug/Delegate.h>
+#include <signalzeug/EventQueue.h>
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+#include <signalzeug/Instrumentation.h>
+#endif
+
+
+namespace signalzeug
+{
+
+/**
+*  @brief
+*    Signal that may be connected, disconnected and fired from multiple threads concurrently
+*
+*    The slots are kept in an immutable list that connect and disconnect replace under a
+*    mutex (copy-on-write). fire takes no lock: it counts itself as a reader, loads the
+*    current list and calls its slots. Replaced lists are deleted, together with the
+*    callbacks of disconnected slots, once no fire is running anymore, by the next change
+*    or by the last fire to return. Thus, a slot disconnected on one thread may still be
+*    called once by a fire that is already running on another thread, but never after
+*    that fire has returned. Slots may connect and disconnect slots of the same signal.
+*
+*    Single-threaded code should use Signal, which does not pay for the synchronization.
+*/
+template <typename... Arguments>
+class ThreadSafeSignal : public AbstractSignal
+{
+public:
+	typedef Delegate<void(Arguments...)> Callback;
+
+	ThreadSafeSignal();
+	virtual ~ThreadSafeSignal();
+
+	ThreadSafeSignal(const ThreadSafeSignal &) = delete;
+	ThreadSafeSignal & operator=(const ThreadSafeSignal &) = delete;
+
+	void fire(Arguments... arguments);
+	void operator()(Arguments... arguments);
+
+	Connection connect(Callback callback) const;
+	Connection connect(ThreadSafeSignal & signal) const;
+
+	template <class T>
+	Connection connect(T * object, void (T::*method)(Arguments...)) const;
+
+	Connection connect(EventQueue & queue, Callback callback, Delivery delivery = Delivery::Queued) const;
+
+	void block();
+	void unblock();
+
+	Connection onFire(std::function<void()> callback) const;
+
+protected:
+	struct Slot
+	{
+		Slot(Connection::Id id, Callback callback);
+
+		Connection::Id id;
+		Callback callback;
+		std::atomic<bool> connected;
+	};
+
+	// Slots are shared by the lists that replace each other
+	typedef std::vector<std::shared_ptr<Slot>> SlotList;
+
+	virtual void disconnect(Connection & connection) const override;
+	virtual void disconnectId(Connection::Id id) const override;
+
+	// Publishes slots as the current list and retires the previous one; called with m_mutex locked
+	void replace(SlotList * slots) const;
+	// Deletes the retired lists if no fire is running; called with m_mutex locked
+	void reclaim() const;
+
+protected:
+	// Serializes connect and disconnect, and guards m_retired
+	mutable std::mutex m_mutex;
+	mutable std::atomic<const SlotList *> m_slots;
+	// Replaced lists that running fires may still use
+	mutable std::vector<const SlotList *> m_retired;
+	mutable std::atomic<bool> m_hasRetired;
+	// Number of running fires, including nested ones
+	std::atomic<size_t> m_firing;
+	std::atomic<bool> m_blocked;
+};
+
+} // namespace signalzeug
+
+#include <signalzeug/ThreadSafeSignal.hpp>
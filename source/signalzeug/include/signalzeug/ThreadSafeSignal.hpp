@@ -0,0 +1,188 @@
+#pragma once
+
+#include <signalzeug/ThreadSafeSignal.h>
+
+namespace signalzeug
+{
+
+template <typename... Arguments>
+ThreadSafeSignal<Arguments...>::Slot::Slot(Connection::Id id, Callback callback)
+: id(id)
+, callback(std::move(callback))
+, connected(true)
+{
+}
+
+template <typename... Arguments>
+ThreadSafeSignal<Arguments...>::ThreadSafeSignal()
+: m_slots(new SlotList)
+, m_hasRetired(false)
+, m_firing(0)
+, m_blocked(false)
+{
+}
+
+template <typename... Arguments>
+ThreadSafeSignal<Arguments...>::~ThreadSafeSignal()
+{
+	for (const auto slots : m_retired)
+		delete slots;
+
+	delete m_slots.load();
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::fire(Arguments... arguments)
+{
+	if (m_blocked)
+		return;
+
+	// Counting as a reader before loading the list keeps it from being deleted,
+	// even if it is replaced meanwhile
+	++m_firing;
+
+	const SlotList & slots = *m_slots.load();
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+	Instrumentation::FireScope fireScope(this);
+#endif
+
+	for (const auto & slot : slots)
+	{
+		if (!slot->connected)
+			continue;
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+		Instrumentation::SlotScope slotScope(this, slot->id);
+#endif
+		slot->callback(arguments...);
+	}
+
+	// The last fire to return deletes the retired lists; if a change holds the mutex,
+	// the change or the next fire does
+	if (--m_firing == 0 && m_hasRetired)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+
+		if (lock.owns_lock())
+			reclaim();
+	}
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::operator()(Arguments... arguments)
+{
+	fire(arguments...);
+}
+
+template <typename... Arguments>
+Connection ThreadSafeSignal<Arguments...>::connect(Callback callback) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	Connection connection = createConnection();
+
+	auto slots = new SlotList(*m_slots.load());
+	slots->push_back(std::make_shared<Slot>(connection.id(), std::move(callback)));
+
+	replace(slots);
+
+	return connection;
+}
+
+template <typename... Arguments>
+template <class T>
+Connection ThreadSafeSignal<Arguments...>::connect(T * object, void (T::*method)(Arguments...)) const
+{
+	return connect(Callback(object, method));
+}
+
+template <typename... Arguments>
+Connection ThreadSafeSignal<Arguments...>::connect(ThreadSafeSignal & signal) const
+{
+	return connect(Callback(&signal, &ThreadSafeSignal::fire));
+}
+
+template <typename... Arguments>
+Connection ThreadSafeSignal<Arguments...>::connect(EventQueue & queue, Callback callback, Delivery delivery) const
+{
+	return connect(queue.queued(std::function<void(Arguments...)>(std::move(callback)), delivery));
+}
+
+template <typename... Arguments>
+Connection ThreadSafeSignal<Arguments...>::onFire(std::function<void()> callback) const
+{
+	return connect([callback](Arguments... /*arguments*/)
+	{
+		callback();
+	});
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::block()
+{
+	m_blocked = true;
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::unblock()
+{
+	m_blocked = false;
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::disconnect(Connection & connection) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	AbstractSignal::disconnect(connection);
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::disconnectId(Connection::Id id) const
+{
+	// Called with m_mutex locked
+	const SlotList & current = *m_slots.load();
+
+	auto slots = new SlotList;
+	slots->reserve(current.size());
+
+	for (const auto & slot : current)
+	{
+		if (slot->id == id)
+		{
+			// Skipped by fires that already hold the previous list
+			slot->connected = false;
+			continue;
+		}
+
+		slots->push_back(slot);
+	}
+
+	replace(slots);
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::replace(SlotList * slots) const
+{
+	m_retired.push_back(m_slots.exchange(slots));
+	m_hasRetired = true;
+
+	reclaim();
+}
+
+template <typename... Arguments>
+void ThreadSafeSignal<Arguments...>::reclaim() const
+{
+	// A fire that starts from now on loads the current list, which is never retired here
+	if (m_firing != 0)
+		return;
+
+	for (const auto slots : m_retired)
+		delete slots;
+
+	m_retired.clear();
+	m_hasRetired = false;
+}
+
+} // namespace signalzeug
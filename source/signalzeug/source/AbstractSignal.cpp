@@ -1,36 +1,128 @@
 
 #include <signalzeug/AbstractSignal.h>
 
+#include <cassert>
+
+#ifdef SIGNALZEUG_INSTRUMENTATION
+#include <signalzeug/Instrumentation.h>
+#endif
+
+namespace
+{
+
+const size_t noHandle = static_cast<size_t>(-1);
+
+size_t indexOf(signalzeug::Connection::Id id)
+{
+	return static_cast<size_t>(id & 0xffffffffu);
+}
+
+std::uint32_t generationOf(signalzeug::Connection::Id id)
+{
+	return static_cast<std::uint32_t>(id >> 32);
+}
+
+} // namespace
+
 namespace signalzeug
 {
 
 AbstractSignal::AbstractSignal()
-: m_nextId(1)
+: m_freeHandle(noHandle)
 {
 }
 
+AbstractSignal::AbstractSignal(const AbstractSignal & other)
+: m_handles(other.m_handles)
+, m_freeHandle(other.m_freeHandle)
+{
+	// Connections keep referring to the original signal
+}
+
 AbstractSignal::~AbstractSignal()
 {
-	for (std::pair<Connection::Id, Connection> pair: m_connections)
-	{
-		Connection & connection = pair.second;
-		connection.detach();
-	}
+#ifdef SIGNALZEUG_INSTRUMENTATION
+	Instrumentation::instance().retire(this);
+#endif
+}
+
+AbstractSignal & AbstractSignal::operator=(const AbstractSignal & other)
+{
+	m_handles = other.m_handles;
+	m_freeHandle = other.m_freeHandle;
+
+	return *this;
 }
 
 Connection AbstractSignal::createConnection() const
 {
-	Connection::Id id = m_nextId++;
-	Connection connection(this, id);
-	m_connections[id] = connection;
+	if (!m_self)
+	{
+		// Not owning; only provides the liveness token for weak references
+		m_self = std::shared_ptr<const AbstractSignal>(this, [] (const AbstractSignal *) {});
+	}
+
+	size_t index = m_freeHandle;
 
-	return connection;
+	if (index != noHandle)
+	{
+		m_freeHandle = m_handles[index].position;
+	}
+	else
+	{
+		assert(m_handles.size() < 0xffffffffu);
+
+		index = m_handles.size();
+		m_handles.push_back(Handle{ 1, false, 0 });
+	}
+
+	Handle & handle = m_handles[index];
+	handle.connected = true;
+	handle.position = 0;
+
+	return Connection(m_self, static_cast<Connection::Id>(handle.generation) << 32 | index);
 }
 
 void AbstractSignal::disconnect(Connection & connection) const
 {
-	m_connections.erase(connection.id());
-	disconnectId(connection.id());
+	const Connection::Id id = connection.id();
+
+	if (!isConnected(id))
+		return;
+
+	disconnectId(id);
+
+	const size_t index = indexOf(id);
+	Handle & handle = m_handles[index];
+
+	// Generation 0 is skipped so that no valid id is 0
+	handle.generation = handle.generation == 0xffffffffu ? 1 : handle.generation + 1;
+	handle.connected = false;
+	handle.position = m_freeHandle;
+	m_freeHandle = index;
+}
+
+bool AbstractSignal::isConnected(Connection::Id id) const
+{
+	const size_t index = indexOf(id);
+
+	return index < m_handles.size()
+		&& m_handles[index].connected
+		&& m_handles[index].generation == generationOf(id);
+}
+
+size_t AbstractSignal::position(Connection::Id id) const
+{
+	assert(isConnected(id));
+
+	return m_handles[indexOf(id)].position;
+}
+
+void AbstractSignal::setPosition(Connection::Id id, size_t position) const
+{
+	assert(isConnected(id));
+
+	m_handles[indexOf(id)].position = position;
 }
 
 } // namespace signalzeug
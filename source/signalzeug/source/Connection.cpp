@@ -6,58 +6,60 @@ namespace signalzeug
 {
 
 Connection::Connection()
+: m_id(0)
 {
 }
 
 Connection::Connection(const Connection & other)
-: m_state(other.m_state)
+: m_signal(other.m_signal)
+, m_id(other.m_id)
 {
 }
 
 Connection::Connection(Connection && other)
-    : m_state(std::move(other.m_state))
+: m_signal(std::move(other.m_signal))
+, m_id(other.m_id)
 {
+	other.m_id = 0;
 }
 
-Connection::Connection(const AbstractSignal * signal, Id id)
-:   m_state(new State { signal, id })
+Connection::Connection(const std::shared_ptr<const AbstractSignal> & signal, Id id)
+: m_signal(signal)
+, m_id(id)
 {
 }
 
 Connection & Connection::operator=(const Connection & other)
 {
-    m_state = other.m_state;
+	m_signal = other.m_signal;
+	m_id = other.m_id;
 
-    return *this;
+	return *this;
 }
 
 Connection & Connection::operator=(Connection && other)
 {
-    m_state = std::move(other.m_state);
+	m_signal = std::move(other.m_signal);
+	m_id = other.m_id;
+	other.m_id = 0;
 
-    return *this;
+	return *this;
 }
 
 Connection::Id Connection::id() const
 {
-	return m_state ? m_state->id : 0;
+	return m_id;
 }
 
 void Connection::disconnect()
 {
-    if (m_state && m_state->signal)
-	{
-		m_state->signal->disconnect(*this);
-		detach();
-	}
-}
+	// Expired if the signal has been destroyed
+	const std::shared_ptr<const AbstractSignal> signal = m_signal.lock();
 
-void Connection::detach()
-{
-	if (m_state)
-	{
-		m_state->signal = nullptr;
-	}
+	if (signal)
+		signal->disconnect(*this);
+
+	m_signal.reset();
 }
 
 } // namespace signalzeug
@@ -0,0 +1,77 @@
+
+#include <signalzeug/EventQueue.h>
+
+namespace signalzeug
+{
+
+EventQueue::EventQueue()
+{
+}
+
+EventQueue::~EventQueue()
+{
+}
+
+void EventQueue::post(Event event)
+{
+	post(nullptr, std::move(event));
+}
+
+void EventQueue::post(const void * key, Event event)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (key)
+		{
+			auto it = m_coalesced.find(key);
+
+			if (it != m_coalesced.end())
+			{
+				m_events[it->second].event = std::move(event);
+				return;
+			}
+
+			m_coalesced[key] = m_events.size();
+		}
+
+		m_events.push_back(Entry{ key, std::move(event) });
+	}
+
+	m_posted.notify_all();
+}
+
+size_t EventQueue::process()
+{
+	std::vector<Entry> events;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		events.swap(m_events);
+		m_coalesced.clear();
+	}
+
+	for (auto & entry : events)
+	{
+		entry.event();
+	}
+
+	return events.size();
+}
+
+bool EventQueue::wait(std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	return m_posted.wait_for(lock, timeout, [this]() { return !m_events.empty(); });
+}
+
+bool EventQueue::empty() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_events.empty();
+}
+
+} // namespace signalzeug
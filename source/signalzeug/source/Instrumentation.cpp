@@ -0,0 +1,382 @@
+
+#include <signalzeug/Instrumentation.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+namespace
+{
+
+// Number of fires in progress on the current thread
+thread_local size_t t_depth = 0;
+
+std::atomic<size_t> s_nextThread(0);
+thread_local size_t t_thread = s_nextThread++;
+
+double microseconds(signalzeug::Instrumentation::Clock::duration duration)
+{
+	return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::string escape(const std::string & string)
+{
+	std::string result;
+	result.reserve(string.size());
+
+	for (const char c : string)
+	{
+		switch (c)
+		{
+		case '"':
+			result += "\\\"";
+			break;
+
+		case '\\':
+			result += "\\\\";
+			break;
+
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+				result += ' ';
+			else
+				result += c;
+			break;
+		}
+	}
+
+	return result;
+}
+
+std::string slotName(const std::string & signalName, signalzeug::Connection::Id id)
+{
+	// The handle index identifies the slot among the slots of the signal
+	std::stringstream stream;
+	stream << signalName << " [slot " << (id & 0xffffffffu) << "]";
+
+	return stream.str();
+}
+
+} // namespace
+
+namespace signalzeug
+{
+
+Instrumentation::FireScope::FireScope(const AbstractSignal * signal)
+: m_signal(nullptr)
+{
+	if (!Instrumentation::instance().isEnabled())
+		return;
+
+	m_signal = signal;
+	++t_depth;
+	m_start = Clock::now();
+}
+
+Instrumentation::FireScope::~FireScope()
+{
+	if (!m_signal)
+		return;
+
+	const Clock::duration duration = Clock::now() - m_start;
+
+	Instrumentation::instance().recordFire(m_signal, m_start, duration, t_depth);
+	--t_depth;
+}
+
+Instrumentation::SlotScope::SlotScope(const AbstractSignal * signal, Connection::Id id)
+: m_signal(nullptr)
+, m_id(id)
+{
+	if (!Instrumentation::instance().isEnabled())
+		return;
+
+	m_signal = signal;
+	m_start = Clock::now();
+}
+
+Instrumentation::SlotScope::~SlotScope()
+{
+	if (!m_signal)
+		return;
+
+	const Clock::duration duration = Clock::now() - m_start;
+
+	Instrumentation::instance().recordSlot(m_signal, m_id, m_start, duration);
+}
+
+Instrumentation & Instrumentation::instance()
+{
+	// Never destroyed, as signals with static storage duration may retire after it
+	static Instrumentation * instrumentation = new Instrumentation;
+
+	return *instrumentation;
+}
+
+bool Instrumentation::isCompiledIn()
+{
+#ifdef SIGNALZEUG_INSTRUMENTATION
+	return true;
+#else
+	return false;
+#endif
+}
+
+Instrumentation::Instrumentation()
+: m_enabled(false)
+, m_tracing(false)
+, m_maximumEvents(0)
+, m_maximumDepth(0)
+, m_epoch(Clock::now())
+{
+}
+
+bool Instrumentation::isEnabled() const
+{
+	return m_enabled.load(std::memory_order_relaxed);
+}
+
+void Instrumentation::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+bool Instrumentation::isTracing() const
+{
+	return m_tracing;
+}
+
+void Instrumentation::setTracing(bool tracing, size_t maximumEvents)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_tracing = tracing;
+	m_maximumEvents = maximumEvents;
+}
+
+void Instrumentation::setName(const AbstractSignal * signal, const std::string & name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_names[signal] = name;
+
+	const auto it = m_indices.find(signal);
+	if (it != m_indices.end())
+		m_signals[it->second].name = name;
+}
+
+void Instrumentation::reset()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (auto & statistics : m_signals)
+	{
+		statistics.fires = 0;
+		statistics.slotCalls = 0;
+		statistics.maximumDepth = 0;
+		statistics.fireTime = Clock::duration::zero();
+	}
+
+	m_slots.clear();
+	m_events.clear();
+	m_maximumDepth = 0;
+	m_epoch = Clock::now();
+}
+
+std::vector<Instrumentation::SignalStatistics> Instrumentation::signalStatistics() const
+{
+	std::vector<SignalStatistics> result;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (const auto & statistics : m_signals)
+		{
+			if (statistics.fires > 0)
+				result.push_back(statistics);
+		}
+	}
+
+	std::stable_sort(result.begin(), result.end(), [] (const SignalStatistics & a, const SignalStatistics & b)
+	{
+		return a.fireTime > b.fireTime;
+	});
+
+	return result;
+}
+
+std::vector<Instrumentation::SlotStatistics> Instrumentation::slotStatistics() const
+{
+	std::vector<SlotStatistics> result;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (const auto & pair : m_slots)
+		{
+			result.push_back(pair.second);
+			result.back().signalName = m_signals[pair.first.first].name;
+		}
+	}
+
+	std::stable_sort(result.begin(), result.end(), [] (const SlotStatistics & a, const SlotStatistics & b)
+	{
+		return a.totalTime > b.totalTime;
+	});
+
+	return result;
+}
+
+size_t Instrumentation::maximumDepth() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_maximumDepth;
+}
+
+void Instrumentation::writeReport(std::ostream & stream, size_t count) const
+{
+	const auto signals = signalStatistics();
+	const auto slots = slotStatistics();
+
+	auto fires = static_cast<size_t>(0);
+	for (const auto & statistics : signals)
+		fires += statistics.fires;
+
+	stream << "Signals: " << fires << " fires of " << signals.size() << " signals, maximum depth " << maximumDepth() << std::endl;
+	stream << std::left << std::setw(40) << "signal"
+		<< std::right << std::setw(10) << "fires" << std::setw(12) << "slot calls"
+		<< std::setw(12) << "total ms" << std::setw(12) << "avg us" << std::setw(10) << "depth" << std::endl;
+
+	for (size_t i = 0; i < signals.size() && i < count; ++i)
+	{
+		const auto & statistics = signals[i];
+
+		stream << std::left << std::setw(40) << statistics.name
+			<< std::right << std::setw(10) << statistics.fires << std::setw(12) << statistics.slotCalls
+			<< std::fixed << std::setprecision(3)
+			<< std::setw(12) << microseconds(statistics.fireTime) / 1000.0
+			<< std::setw(12) << microseconds(statistics.fireTime) / statistics.fires
+			<< std::setw(10) << statistics.maximumDepth << std::endl;
+	}
+
+	stream << std::endl;
+	stream << std::left << std::setw(40) << "slot"
+		<< std::right << std::setw(10) << "calls" << std::setw(12) << "total ms"
+		<< std::setw(12) << "avg us" << std::setw(12) << "max us" << std::endl;
+
+	for (size_t i = 0; i < slots.size() && i < count; ++i)
+	{
+		const auto & statistics = slots[i];
+
+		stream << std::left << std::setw(40) << slotName(statistics.signalName, statistics.id)
+			<< std::right << std::setw(10) << statistics.calls
+			<< std::fixed << std::setprecision(3)
+			<< std::setw(12) << microseconds(statistics.totalTime) / 1000.0
+			<< std::setw(12) << microseconds(statistics.totalTime) / statistics.calls
+			<< std::setw(12) << microseconds(statistics.maximumTime) << std::endl;
+	}
+}
+
+void Instrumentation::writeChromeTrace(std::ostream & stream) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	stream << "{\"traceEvents\":[";
+
+	for (size_t i = 0; i < m_events.size(); ++i)
+	{
+		const auto & event = m_events[i];
+		const auto & name = m_signals[event.signal].name;
+
+		stream << (i > 0 ? ",\n" : "\n")
+			<< "{\"name\":\"" << escape(event.id ? slotName(name, event.id) : name) << "\""
+			<< ",\"cat\":\"" << (event.id ? "slot" : "fire") << "\""
+			<< ",\"ph\":\"X\""
+			<< std::fixed << std::setprecision(3)
+			<< ",\"ts\":" << microseconds(event.start - m_epoch)
+			<< ",\"dur\":" << microseconds(event.duration)
+			<< ",\"pid\":0,\"tid\":" << event.thread << "}";
+	}
+
+	stream << "\n],\"displayTimeUnit\":\"ns\"}" << std::endl;
+}
+
+void Instrumentation::retire(const AbstractSignal * signal)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_names.erase(signal);
+	m_indices.erase(signal);
+}
+
+void Instrumentation::recordFire(const AbstractSignal * signal, Clock::time_point start, Clock::duration duration, size_t depth)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const size_t index = indexOf(signal);
+	auto & statistics = m_signals[index];
+
+	++statistics.fires;
+	statistics.fireTime += duration;
+	statistics.maximumDepth = std::max(statistics.maximumDepth, depth);
+
+	m_maximumDepth = std::max(m_maximumDepth, depth);
+
+	if (m_tracing && m_events.size() < m_maximumEvents)
+		m_events.push_back(TraceEvent{ index, 0, t_thread, start, duration });
+}
+
+void Instrumentation::recordSlot(const AbstractSignal * signal, Connection::Id id, Clock::time_point start, Clock::duration duration)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const size_t index = indexOf(signal);
+
+	++m_signals[index].slotCalls;
+
+	auto it = m_slots.find(std::make_pair(index, id));
+
+	if (it == m_slots.end())
+		it = m_slots.insert(std::make_pair(std::make_pair(index, id), SlotStatistics{ std::string(), id, 0, Clock::duration::zero(), Clock::duration::zero() })).first;
+
+	auto & statistics = it->second;
+
+	++statistics.calls;
+	statistics.totalTime += duration;
+	statistics.maximumTime = std::max(statistics.maximumTime, duration);
+
+	if (m_tracing && m_events.size() < m_maximumEvents)
+		m_events.push_back(TraceEvent{ index, id, t_thread, start, duration });
+}
+
+size_t Instrumentation::indexOf(const AbstractSignal * signal)
+{
+	const auto it = m_indices.find(signal);
+
+	if (it != m_indices.end())
+		return it->second;
+
+	std::string name;
+
+	const auto named = m_names.find(signal);
+	if (named != m_names.end())
+	{
+		name = named->second;
+	}
+	else
+	{
+		std::stringstream stream;
+		stream << "signal@" << static_cast<const void *>(signal);
+		name = stream.str();
+	}
+
+	const size_t index = m_signals.size();
+	m_signals.push_back(SignalStatistics{ name, 0, 0, 0, Clock::duration::zero() });
+	m_indices[signal] = index;
+
+	return index;
+}
+
+} // namespace signalzeug
@@ -0,0 +1,159 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <loggingzeug/AsyncLogHandler.h>
+
+
+using namespace loggingzeug;
+
+namespace
+{
+
+const char * const logfile = "async_log_handler_test.log";
+
+std::vector<std::string> readLines(const std::string & filename)
+{
+    std::ifstream stream(filename);
+    std::vector<std::string> lines;
+
+    for (std::string line; std::getline(stream, line); )
+        lines.push_back(line);
+
+    return lines;
+}
+
+} // namespace
+
+class async_log_handler_test : public testing::Test
+{
+public:
+    async_log_handler_test()
+    {
+        std::remove(logfile);
+    }
+
+    ~async_log_handler_test()
+    {
+        std::remove(logfile);
+    }
+
+protected:
+    // Logs large messages until the writer falls behind and one is dropped
+    size_t logUntilDropped(AsyncLogHandler & handler)
+    {
+        const auto padding = std::string(1000, 'x');
+        auto sent = size_t(0);
+
+        while (handler.droppedMessages() == 0 && sent < 1000000)
+            handler.handle(LogMessage(LogMessage::Info, std::to_string(sent++) + " " + padding, ""));
+
+        return sent;
+    }
+};
+
+TEST_F(async_log_handler_test, Prefix)
+{
+    {
+        AsyncLogHandler handler(logfile);
+
+        handler.handle(LogMessage(LogMessage::Info, "info", ""));
+        handler.handle(LogMessage(LogMessage::Warning, "warning", "context"));
+        handler.handle(LogMessage(LogMessage::Debug, "debug", "context"));
+    }
+
+    ASSERT_EQ((std::vector<std::string>{ "info", "#warning [context]: warning", "[context]: debug" }), readLines(logfile));
+}
+
+TEST_F(async_log_handler_test, DropCountsDiscardedMessages)
+{
+    AsyncLogHandler handler(logfile, 4, AsyncLogHandler::OverflowPolicy::Drop);
+
+    const auto sent = logUntilDropped(handler);
+    ASSERT_LT(0u, handler.droppedMessages());
+
+    handler.flush();
+
+    const auto lines = readLines(logfile);
+    ASSERT_EQ(sent, lines.size() + handler.droppedMessages());
+
+    // The new message is discarded
+    ASSERT_EQ(0u, lines.front().find("0 "));
+}
+
+TEST_F(async_log_handler_test, DropOldestCountsDiscardedMessages)
+{
+    AsyncLogHandler handler(logfile, 4, AsyncLogHandler::OverflowPolicy::DropOldest);
+
+    const auto sent = logUntilDropped(handler);
+    ASSERT_LT(0u, handler.droppedMessages());
+
+    handler.flush();
+
+    const auto lines = readLines(logfile);
+    ASSERT_EQ(sent, lines.size() + handler.droppedMessages());
+
+    // The last message is always kept
+    ASSERT_EQ(0u, lines.back().find(std::to_string(sent - 1) + " "));
+}
+
+TEST_F(async_log_handler_test, BlockKeepsAllMessages)
+{
+    const auto threadCount = 4;
+    const auto messagesPerThread = 2000;
+
+    {
+        AsyncLogHandler handler(logfile, 2, AsyncLogHandler::OverflowPolicy::Block);
+
+        auto threads = std::vector<std::thread>();
+
+        for (auto i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&handler, i] () {
+                for (auto j = 0; j < messagesPerThread; ++j)
+                    handler.handle(LogMessage(LogMessage::Info, std::to_string(j), std::to_string(i)));
+            });
+        }
+
+        for (auto & thread : threads)
+            thread.join();
+
+        ASSERT_EQ(0u, handler.droppedMessages());
+    }
+
+    const auto lines = readLines(logfile);
+    ASSERT_EQ(static_cast<size_t>(threadCount * messagesPerThread), lines.size());
+
+    // The messages of each thread are written in order
+    auto next = std::vector<int>(threadCount, 0);
+
+    for (const auto & line : lines)
+    {
+        const auto thread = std::stoi(line.substr(1));
+        const auto message = std::stoi(line.substr(line.find(": ") + 2));
+
+        ASSERT_EQ(next[thread], message);
+        ++next[thread];
+    }
+}
+
+TEST_F(async_log_handler_test, FatalIsWrittenBeforeReturning)
+{
+    AsyncLogHandler handler(logfile, 4, AsyncLogHandler::OverflowPolicy::Drop);
+
+    for (auto i = 0; i < 3; ++i)
+        handler.handle(LogMessage(LogMessage::Info, std::to_string(i), ""));
+
+    handler.handle(LogMessage(LogMessage::Fatal, "fatal", ""));
+
+    // Read while the handler is still open
+    const auto lines = readLines(logfile);
+
+    ASSERT_FALSE(lines.empty());
+    ASSERT_EQ("#fatal: fatal", lines.back());
+    ASSERT_EQ(lines.size() + handler.droppedMessages(), 4u);
+}
@@ -0,0 +1,177 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <loggingzeug/BinaryLogHandler.h>
+#include <loggingzeug/BinaryLogReader.h>
+#include <loggingzeug/LogRecord.h>
+
+
+using namespace loggingzeug;
+
+namespace
+{
+
+const char * const logfile = "binary_log_test.lzb";
+
+template <typename... Args>
+LogRecord makeRecord(LogMessage::Level level, const char * format, const std::string & context, const Args &... args)
+{
+    std::string arguments;
+    LogRecord::encode(arguments, args...);
+
+    return LogRecord(level, format, context, arguments);
+}
+
+std::string readFile(const std::string & filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string & filename, const std::string & content)
+{
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+} // namespace
+
+class binary_log_test : public testing::Test
+{
+public:
+    binary_log_test()
+    {
+        std::remove(logfile);
+    }
+
+    ~binary_log_test()
+    {
+        std::remove(logfile);
+    }
+
+protected:
+    // Reads all records as "level context: message"
+    std::vector<std::string> readRecords(bool & valid)
+    {
+        BinaryLogReader reader(logfile);
+        auto record = LogRecord(LogMessage::Info, nullptr, std::string(), std::string());
+        auto records = std::vector<std::string>();
+
+        while (reader.read(record))
+            records.push_back(std::to_string(record.level()) + " " + record.context() + ": " + record.message());
+
+        valid = reader.isValid();
+        return records;
+    }
+
+    void writeSession(const std::string & name)
+    {
+        BinaryLogHandler handler(logfile);
+
+        handler.handleRecord(makeRecord(LogMessage::Info, "%; session %;", "", name, 1));
+        handler.handleRecord(makeRecord(LogMessage::Warning, "%; session %; at %f.2;", name, name, 2, 0.5));
+        handler.handle(LogMessage(LogMessage::Debug, name + " text", "text"));
+        handler.handleRecord(makeRecord(LogMessage::Info, "%; session %;", "", name, 3));
+    }
+
+    std::vector<std::string> expectedSession(const std::string & name)
+    {
+        return std::vector<std::string>{
+            "4 : " + name + " session 1",
+            "2 " + name + ": " + name + " session 2 at 0.50",
+            "3 text: " + name + " text",
+            "4 : " + name + " session 3"
+        };
+    }
+};
+
+TEST_F(binary_log_test, RoundTrip)
+{
+    writeSession("first");
+
+    auto valid = false;
+    ASSERT_EQ(expectedSession("first"), readRecords(valid));
+    ASSERT_TRUE(valid);
+}
+
+TEST_F(binary_log_test, AppendedSession)
+{
+    writeSession("first");
+    writeSession("second");
+
+    auto expected = expectedSession("first");
+    const auto second = expectedSession("second");
+    expected.insert(expected.end(), second.begin(), second.end());
+
+    auto valid = false;
+    ASSERT_EQ(expected, readRecords(valid));
+    ASSERT_TRUE(valid);
+}
+
+TEST_F(binary_log_test, TruncatedFile)
+{
+    writeSession("first");
+
+    const auto content = readFile(logfile);
+    writeFile(logfile, content.substr(0, content.size() - 5));
+
+    auto valid = true;
+    auto records = readRecords(valid);
+
+    auto expected = expectedSession("first");
+    expected.pop_back();
+
+    ASSERT_EQ(expected, records);
+    ASSERT_FALSE(valid);
+
+    // The cut off record is removed before the next session is appended
+    writeSession("second");
+
+    const auto second = expectedSession("second");
+    expected.insert(expected.end(), second.begin(), second.end());
+
+    ASSERT_EQ(expected, readRecords(valid));
+    ASSERT_TRUE(valid);
+}
+
+TEST_F(binary_log_test, TruncatedHeader)
+{
+    writeSession("first");
+    writeFile(logfile, readFile(logfile).substr(0, 3));
+
+    writeSession("second");
+
+    auto valid = false;
+    ASSERT_EQ(expectedSession("second"), readRecords(valid));
+    ASSERT_TRUE(valid);
+}
+
+TEST_F(binary_log_test, CorruptFile)
+{
+    writeSession("first");
+    writeFile(logfile, readFile(logfile) + "?");
+
+    auto valid = true;
+    ASSERT_EQ(expectedSession("first"), readRecords(valid));
+    ASSERT_FALSE(valid);
+}
+
+TEST_F(binary_log_test, IncompatibleFileIsUntouched)
+{
+    const auto text = std::string("a text log file\n");
+    writeFile(logfile, text);
+
+    {
+        BinaryLogHandler handler(logfile);
+        handler.handle(LogMessage(LogMessage::Info, "discarded", ""));
+    }
+
+    ASSERT_EQ(text, readFile(logfile));
+    ASSERT_FALSE(BinaryLogReader(logfile).isValid());
+}
@@ -0,0 +1,138 @@
+#include <gmock/gmock.h>
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <loggingzeug/formatString.h>
+
+
+using namespace loggingzeug;
+
+class format_string_test : public testing::Test
+{
+public:
+    format_string_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(format_string_test, Arguments)
+{
+    ASSERT_EQ("plain", formatString("plain"));
+    ASSERT_EQ("42", formatString("%;", 42));
+    ASSERT_EQ("a 1, b 2.5, c text", formatString("a %;, b %;, c %;", 1, 2.5, "text"));
+    ASSERT_EQ("string c A", formatString("%; %; %;", std::string("string"), 'c', static_cast<unsigned char>(65)));
+    ASSERT_EQ("-9223372036854775808", formatString("%;", static_cast<long long>(-9223372036854775807ll - 1)));
+}
+
+TEST_F(format_string_test, SurplusArguments)
+{
+    ASSERT_EQ("1", formatString("%;", 1, 2, 3));
+    ASSERT_EQ("none", formatString("none", 1));
+}
+
+TEST_F(format_string_test, MissingArguments)
+{
+    // The text behind the last argument is written as is
+    ASSERT_EQ("1 and %; and %;", formatString("%; and %; and %;", 1));
+    ASSERT_EQ("1 %d;", formatString("%; %d;", 1));
+}
+
+TEST_F(format_string_test, EscapedPercent)
+{
+    ASSERT_EQ("100% 5", formatString("100%% %;", 5));
+
+    // Not escaped behind the last argument
+    ASSERT_EQ("5 %%", formatString("%; %%", 5));
+}
+
+TEST_F(format_string_test, Base)
+{
+    ASSERT_EQ("ff", formatString("%x;", 255));
+    ASSERT_EQ("10", formatString("%o;", 8));
+    ASSERT_EQ("0xff", formatString("%#x;", 255));
+    ASSERT_EQ("FF", formatString("%ux;", 255));
+
+    // Only lowercase base flags are recognized
+    ASSERT_EQ("255", formatString("%X;", 255));
+}
+
+TEST_F(format_string_test, HexOfNegativeIntegers)
+{
+    // As unsigned of the size of the argument
+    ASSERT_EQ("ffff", formatString("%x;", static_cast<short>(-1)));
+    ASSERT_EQ("ffffffff", formatString("%x;", -1));
+    ASSERT_EQ("fffffffffffffffe", formatString("%x;", static_cast<long long>(-2)));
+    ASSERT_EQ("ffffffffffffffff", formatString("%x;", static_cast<unsigned long long>(-1)));
+}
+
+TEST_F(format_string_test, FillAndWidth)
+{
+    ASSERT_EQ("7-----|", formatString("%l?-6;|", 7));
+    ASSERT_EQ("    ab|", formatString("%r6;|", "ab"));
+    ASSERT_EQ("0000000003", formatString("%010;", 3));
+    ASSERT_EQ("3", formatString("%0;", 3));
+}
+
+TEST_F(format_string_test, FillAndPrecisionCarryOver)
+{
+    // Fill and precision persist to the following specifiers, the width does not
+    ASSERT_EQ("*******1|2|", formatString("%?*8;|%;|", 1, 2));
+    ASSERT_EQ("***1|****2|", formatString("%?*4;|%5;|", 1, 2));
+    ASSERT_EQ("3.14|2.72", formatString("%.3;|%;", 3.14159265, 2.718281828));
+    ASSERT_EQ("3.14|2.7", formatString("%f.2;|%;", 3.14159265, 2.718281828));
+}
+
+TEST_F(format_string_test, InternalPadding)
+{
+    ASSERT_EQ("-0000042", formatString("%i?08;", -42));
+    ASSERT_EQ("+000000042", formatString("%i+?010;", 42));
+    ASSERT_EQ("0x0000ff", formatString("%i#?08x;", 255));
+}
+
+TEST_F(format_string_test, FloatingPoint)
+{
+    ASSERT_EQ("1.234568e+04", formatString("%e;", 12345.678));
+    ASSERT_EQ("1.234568E+04", formatString("%E;", 12345.678));
+    ASSERT_EQ("0.500000", formatString("%F;", 0.5));
+    ASSERT_EQ("1.00000", formatString("%p;", 1.0));
+    ASSERT_EQ("     3.142", formatString("%10.4f;", 3.14159));
+    ASSERT_EQ("0.10000000000000000555", formatString("%.20;", 0.1));
+    ASSERT_EQ("0.333333 1e+300 -0", formatString("%; %; %;", 1.0f / 3, 1e300, -0.0));
+    ASSERT_EQ("0.333333", formatString("%;", static_cast<long double>(1) / 3));
+
+    // A single floatfield flag is recognized
+    ASSERT_EQ("1.000000e-01", formatString("%ef;", 0.1));
+}
+
+TEST_F(format_string_test, Flags)
+{
+    ASSERT_EQ("true|0", formatString("%a;|%;", true, false));
+    ASSERT_EQ("+3", formatString("%+;", 3));
+}
+
+TEST_F(format_string_test, HexFloat)
+{
+    // Hexfloat cannot be set by the format, but is taken from the stream
+    std::ostringstream stream;
+    stream << std::hexfloat;
+
+    streamprintf(stream, "%;|%u;|", 1.0, 255.5);
+    streamprintf(stream, "%;", -0.1);
+
+    ASSERT_EQ("0x1p+0|0X1.FFP+7|-0x1.999999999999ap-4", stream.str());
+}
+
+TEST_F(format_string_test, StreamState)
+{
+    // Like streaming the arguments, the stream keeps the fill and precision
+    std::ostringstream stream;
+
+    streamprintf(stream, "%?#.3;", 3.14159);
+    stream << std::setw(5) << 1.41421;
+
+    ASSERT_EQ("3.14#1.41", stream.str());
+}
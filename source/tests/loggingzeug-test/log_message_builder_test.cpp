@@ -0,0 +1,189 @@
+#include <gmock/gmock.h>
+
+#include <array>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/LogMessageBuilder.h>
+
+
+using namespace loggingzeug;
+
+namespace
+{
+
+class LastMessageHandler : public AbstractLogHandler
+{
+public:
+    virtual void handle(const LogMessage & message) override
+    {
+        last = message.message();
+        ++count;
+    }
+
+    std::string last;
+    int count = 0;
+};
+
+} // namespace
+
+// Streams the same values into a std::ostringstream and a LogMessageBuilder and compares the results
+#define EXPECT_AS_STREAMED(STREAMED) \
+    { \
+        std::ostringstream stream; \
+        stream STREAMED; \
+        build() STREAMED; \
+        EXPECT_EQ(stream.str(), m_handler.last); \
+    }
+
+class log_message_builder_test : public testing::Test
+{
+public:
+    log_message_builder_test()
+    {
+    }
+
+protected:
+    LogMessageBuilder build()
+    {
+        return LogMessageBuilder(LogMessage::Info, &m_handler, std::string("test"));
+    }
+
+protected:
+    LastMessageHandler m_handler;
+};
+
+TEST_F(log_message_builder_test, Text)
+{
+    build() << "a" << std::string("b") << 'c' << static_cast<unsigned char>(65);
+    ASSERT_EQ("abcA", m_handler.last);
+
+    build() << "line" << std::endl << std::flush;
+    ASSERT_EQ("line\n", m_handler.last);
+
+    // Strings are not padded; the width applies to the next number or character
+    build() << std::setw(4) << "ab" << 1;
+    ASSERT_EQ("ab   1", m_handler.last);
+
+    EXPECT_AS_STREAMED(<< std::setw(3) << 'c' << std::left << std::setw(3) << 'd' << '|');
+}
+
+TEST_F(log_message_builder_test, Bool)
+{
+    // Always written as text, regardless of boolalpha
+    build() << true << " " << false;
+    ASSERT_EQ("true false", m_handler.last);
+}
+
+TEST_F(log_message_builder_test, Integers)
+{
+    EXPECT_AS_STREAMED(<< 0 << " " << -42 << " " << 42u);
+    EXPECT_AS_STREAMED(<< std::numeric_limits<long>::min() << " " << std::numeric_limits<unsigned long>::max());
+    EXPECT_AS_STREAMED(<< std::numeric_limits<long long>::min() << " " << std::numeric_limits<unsigned long long>::max());
+    EXPECT_AS_STREAMED(<< std::numeric_limits<int>::min() << " " << std::numeric_limits<unsigned>::max());
+}
+
+TEST_F(log_message_builder_test, IntegerManipulators)
+{
+    EXPECT_AS_STREAMED(<< std::hex << 255 << " " << -1 << " " << std::dec << 255);
+    EXPECT_AS_STREAMED(<< std::oct << 8 << " " << std::showbase << 8 << " " << std::hex << 255);
+    EXPECT_AS_STREAMED(<< std::showbase << std::uppercase << std::hex << 255 << " " << 0);
+    EXPECT_AS_STREAMED(<< std::showpos << 42 << " " << 42u << " " << -42 << std::noshowpos << " " << 42);
+    EXPECT_AS_STREAMED(<< std::setw(6) << std::setfill('*') << 42 << "|" << 42);
+    EXPECT_AS_STREAMED(<< std::left << std::setw(6) << -42 << "|" << std::right << std::setw(6) << -42);
+    EXPECT_AS_STREAMED(<< std::internal << std::setfill('0') << std::setw(8) << -42);
+    EXPECT_AS_STREAMED(<< std::internal << std::showbase << std::hex << std::setw(8) << 255);
+    EXPECT_AS_STREAMED(<< std::hex << static_cast<long long>(-2) << " " << static_cast<unsigned long long>(-1));
+}
+
+TEST_F(log_message_builder_test, FloatingPoint)
+{
+    EXPECT_AS_STREAMED(<< 1.0f / 3 << " " << 2.0 / 3 << " " << static_cast<long double>(1) / 3);
+    EXPECT_AS_STREAMED(<< 1e300 << " " << -0.0 << " " << 0.1 << " " << 100.0 << " " << 1e-5);
+    EXPECT_AS_STREAMED(<< std::numeric_limits<double>::infinity() << " " << -std::numeric_limits<double>::infinity());
+}
+
+TEST_F(log_message_builder_test, FloatingPointManipulators)
+{
+    EXPECT_AS_STREAMED(<< std::fixed << std::setprecision(2) << 3.14159 << " " << 2.0);
+    EXPECT_AS_STREAMED(<< std::scientific << 12345.678 << " " << std::uppercase << 12345.678);
+    EXPECT_AS_STREAMED(<< std::setprecision(3) << 3.14159 << " " << std::showpoint << 1.0);
+    EXPECT_AS_STREAMED(<< std::fixed << 1.5 << " " << std::defaultfloat << 1.5);
+    EXPECT_AS_STREAMED(<< std::hexfloat << 1.0 << " " << -0.1 << " " << std::uppercase << 255.5);
+    EXPECT_AS_STREAMED(<< std::showpos << std::internal << std::setw(10) << 3.5);
+    EXPECT_AS_STREAMED(<< std::setprecision(20) << 0.1 << " " << std::setprecision(0) << 0.1);
+}
+
+TEST_F(log_message_builder_test, Pointers)
+{
+    const auto value = 42;
+
+    EXPECT_AS_STREAMED(<< static_cast<const void *>(&value));
+    EXPECT_AS_STREAMED(<< std::uppercase << std::oct << static_cast<const void *>(&value) << " " << 8);
+
+    std::ostringstream stream;
+    stream << static_cast<const void *>(&value);
+
+    build() << &value;
+    ASSERT_EQ(stream.str(), m_handler.last);
+}
+
+TEST_F(log_message_builder_test, Containers)
+{
+    build() << std::vector<int>{ 1, 2, 3 } << " " << std::vector<int>();
+    ASSERT_EQ("vector(1, 2, 3) vector()", m_handler.last);
+
+    build() << std::array<double, 2>{ { 0.5, 1.5 } };
+    ASSERT_EQ("array(0.5, 1.5)", m_handler.last);
+}
+
+TEST_F(log_message_builder_test, LongMessage)
+{
+    // Beyond the inline capacity of the buffer
+    const auto text = std::string(1000, 'x');
+
+    build() << text << 42 << text;
+    ASSERT_EQ(text + "42" + text, m_handler.last);
+}
+
+TEST_F(log_message_builder_test, Format)
+{
+    build().format("%; and %x;", 10, 255);
+    ASSERT_EQ("10 and ff", m_handler.last);
+
+    // Appended to streamed text, with the format state of the builder
+    (build() << "values " << std::setfill('*')).format("%3;|%;", 1, 2);
+    ASSERT_EQ("values **1|2", m_handler.last);
+
+    // The fill set by the format is kept for streamed values
+    build().format("%?-4;", 1) << "|" << std::setw(3) << 2;
+    ASSERT_EQ("---1|--2", m_handler.last);
+}
+
+TEST_F(log_message_builder_test, MovedBuilder)
+{
+    {
+        auto builder = build();
+        builder << "moved";
+
+        auto moved = std::move(builder);
+        moved << " once";
+    }
+
+    ASSERT_EQ("moved once", m_handler.last);
+    ASSERT_EQ(1, m_handler.count);
+}
+
+TEST_F(log_message_builder_test, Discarded)
+{
+    {
+        LogMessageBuilder builder(LogMessage::Debug, static_cast<AbstractLogHandler *>(nullptr), std::string());
+        builder << "discarded " << 42 << std::hex << 1.5;
+    }
+
+    ASSERT_EQ(0, m_handler.count);
+}
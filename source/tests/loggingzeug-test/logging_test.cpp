@@ -0,0 +1,85 @@
+#include <gmock/gmock.h>
+
+#include <thread>
+
+#include <loggingzeug/AbstractLogHandler.h>
+#include <loggingzeug/LogContext.h>
+#include <loggingzeug/logging.h>
+
+
+using namespace loggingzeug;
+
+namespace
+{
+
+class NullHandler : public AbstractLogHandler
+{
+public:
+    virtual void handle(const LogMessage &) override
+    {
+    }
+};
+
+} // namespace
+
+class logging_test : public testing::Test
+{
+public:
+    logging_test()
+    : m_handler(new NullHandler)
+    {
+        addLoggingHandler(m_handler, LogMessage::Info);
+    }
+
+    ~logging_test()
+    {
+        removeLoggingHandler(m_handler);
+        setVerbosityLevel(LogMessage::Info);
+    }
+
+protected:
+    NullHandler * m_handler;
+};
+
+TEST_F(logging_test, EnabledLevel)
+{
+    const LogContext context("logging_test");
+
+    setVerbosityLevel(LogMessage::Warning);
+    ASSERT_TRUE(isEnabled(LogMessage::Warning));
+    ASSERT_FALSE(isEnabled(LogMessage::Info));
+
+    context.setVerbosityLevel(LogMessage::Info);
+    ASSERT_TRUE(isEnabled(LogMessage::Info));
+
+    context.resetVerbosityLevel();
+    ASSERT_FALSE(isEnabled(LogMessage::Info));
+}
+
+TEST_F(logging_test, ConcurrentLevelChanges)
+{
+    const LogContext context("logging_test");
+
+    // Whichever update comes last has to see both final levels
+    std::thread global([] () {
+        for (auto i = 0; i < 10000; ++i)
+        {
+            setVerbosityLevel(LogMessage::Info);
+            setVerbosityLevel(LogMessage::Warning);
+        }
+    });
+
+    std::thread contextual([&context] () {
+        for (auto i = 0; i < 10000; ++i)
+        {
+            context.setVerbosityLevel(LogMessage::Info);
+            context.resetVerbosityLevel();
+        }
+    });
+
+    global.join();
+    contextual.join();
+
+    ASSERT_TRUE(isEnabled(LogMessage::Warning));
+    ASSERT_FALSE(isEnabled(LogMessage::Info));
+}
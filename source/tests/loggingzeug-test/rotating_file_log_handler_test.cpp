@@ -0,0 +1,162 @@
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <loggingzeug/RotatingFileLogHandler.h>
+
+
+using namespace loggingzeug;
+
+namespace
+{
+
+const std::string logfile = "rotating_file_log_handler_test.log";
+
+std::string generationName(size_t generation)
+{
+    return logfile + "." + std::to_string(generation);
+}
+
+std::vector<std::string> readLines(const std::string & filename)
+{
+    std::ifstream stream(filename);
+    std::vector<std::string> lines;
+
+    for (std::string line; std::getline(stream, line); )
+        lines.push_back(line);
+
+    return lines;
+}
+
+bool exists(const std::string & filename)
+{
+    return std::ifstream(filename).good();
+}
+
+void log(RotatingFileLogHandler & handler, const std::string & text)
+{
+    handler.handle(LogMessage(LogMessage::Info, text, ""));
+}
+
+} // namespace
+
+class rotating_file_log_handler_test : public testing::Test
+{
+public:
+    rotating_file_log_handler_test()
+    {
+        removeFiles();
+    }
+
+    ~rotating_file_log_handler_test()
+    {
+        removeFiles();
+    }
+
+protected:
+    void removeFiles()
+    {
+        std::remove(logfile.c_str());
+
+        for (auto generation = 1; generation <= 4; ++generation)
+            std::remove(generationName(generation).c_str());
+    }
+};
+
+TEST_F(rotating_file_log_handler_test, SizeRotation)
+{
+    {
+        // Each message takes 5 bytes including the newline
+        RotatingFileLogHandler handler(logfile, 20, 2);
+
+        for (auto i = 0; i < 5; ++i)
+            log(handler, "msg" + std::to_string(i));
+    }
+
+    ASSERT_EQ((std::vector<std::string>{ "msg0", "msg1", "msg2", "msg3" }), readLines(generationName(1)));
+    ASSERT_EQ((std::vector<std::string>{ "msg4" }), readLines(logfile));
+    ASSERT_FALSE(exists(generationName(2)));
+}
+
+TEST_F(rotating_file_log_handler_test, ExistingFileCountsTowardsSize)
+{
+    {
+        std::ofstream stream(logfile);
+        stream << "old line\n";
+    }
+
+    {
+        RotatingFileLogHandler handler(logfile, 12, 2);
+        log(handler, "msg0");
+    }
+
+    ASSERT_EQ((std::vector<std::string>{ "old line" }), readLines(generationName(1)));
+    ASSERT_EQ((std::vector<std::string>{ "msg0" }), readLines(logfile));
+}
+
+TEST_F(rotating_file_log_handler_test, GenerationRenaming)
+{
+    {
+        // Every message rotates the file
+        RotatingFileLogHandler handler(logfile, 5, 2);
+
+        for (auto i = 0; i < 5; ++i)
+            log(handler, "msg" + std::to_string(i));
+
+        handler.flush();
+
+        ASSERT_EQ((std::vector<std::string>{ "msg4" }), readLines(logfile));
+        ASSERT_EQ((std::vector<std::string>{ "msg3" }), readLines(generationName(1)));
+        ASSERT_EQ((std::vector<std::string>{ "msg2" }), readLines(generationName(2)));
+    }
+
+    // The oldest generations are removed
+    ASSERT_FALSE(exists(generationName(3)));
+}
+
+TEST_F(rotating_file_log_handler_test, NoGenerations)
+{
+    {
+        RotatingFileLogHandler handler(logfile, 10, 0);
+
+        for (auto i = 0; i < 5; ++i)
+            log(handler, "msg" + std::to_string(i));
+    }
+
+    ASSERT_EQ((std::vector<std::string>{ "msg4" }), readLines(logfile));
+    ASSERT_FALSE(exists(generationName(1)));
+}
+
+TEST_F(rotating_file_log_handler_test, IntervalRotation)
+{
+    {
+        RotatingFileLogHandler handler(logfile, 1 << 20, 2);
+        handler.setRotationInterval(std::chrono::seconds(1));
+
+        log(handler, "first");
+        log(handler, "second");
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+        log(handler, "third");
+    }
+
+    ASSERT_EQ((std::vector<std::string>{ "first", "second" }), readLines(generationName(1)));
+    ASSERT_EQ((std::vector<std::string>{ "third" }), readLines(logfile));
+}
+
+TEST_F(rotating_file_log_handler_test, CriticalIsWrittenImmediately)
+{
+    RotatingFileLogHandler handler(logfile, 1 << 20, 2);
+
+    log(handler, "buffered");
+    ASSERT_TRUE(readLines(logfile).empty());
+
+    handler.handle(LogMessage(LogMessage::Critical, "critical", ""));
+    ASSERT_EQ((std::vector<std::string>{ "buffered", "#critical: critical" }), readLines(logfile));
+}
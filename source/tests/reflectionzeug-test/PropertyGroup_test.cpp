@@ -0,0 +1,216 @@
+#include <gmock/gmock.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <reflectionzeug/property/PropertyGroup.h>
+#include <reflectionzeug/property/Property.h>
+#include <reflectionzeug/property/AccessorValue.h>
+#include <reflectionzeug/property/ArrayAccessorValue.h>
+
+using namespace reflectionzeug;
+
+
+class PropertyGroup_test : public testing::Test
+{
+public:
+    PropertyGroup_test()
+    {
+        m_first = m_group.addProperty<int>("first", new AccessorValue<int>(0));
+        m_second = m_group.addProperty<int>("second", new AccessorValue<int>(0));
+        m_sub = m_group.addGroup("sub");
+        m_third = m_sub->addProperty<std::string>("third", new AccessorValue<std::string>());
+    }
+
+protected:
+    PropertyGroup m_group;
+    Property<int> * m_first;
+    Property<int> * m_second;
+    PropertyGroup * m_sub;
+    Property<std::string> * m_third;
+};
+
+
+TEST_F(PropertyGroup_test, SetValueNotifiesImmediately)
+{
+    auto changes = 0;
+    m_first->changed.connect([&changes] () { ++changes; });
+
+    m_first->setValue(1);
+    m_first->setValue(2);
+
+    ASSERT_EQ(2, changes);
+}
+
+TEST_F(PropertyGroup_test, BatchUpdateNotifiesOncePerPropertyAfterwards)
+{
+    auto firstChanges = 0;
+    auto lastValue = 0;
+    auto thirdChanges = 0;
+
+    m_first->changed.connect([&firstChanges] () { ++firstChanges; });
+    m_first->valueChanged.connect([&lastValue] (const int & value) { lastValue = value; });
+    m_third->changed.connect([&thirdChanges] () { ++thirdChanges; });
+
+    {
+        PropertyGroup::BatchUpdate batch(m_group);
+
+        m_first->setValue(1);
+        m_first->setValue(2);
+        m_first->setValue(3);
+        m_third->setValue("third");
+
+        ASSERT_EQ(0, firstChanges);
+        ASSERT_EQ(0, thirdChanges);
+        ASSERT_EQ(3, m_first->value());
+    }
+
+    ASSERT_EQ(1, firstChanges);
+    ASSERT_EQ(3, lastValue);
+    ASSERT_EQ(1, thirdChanges);
+
+    // Notifications are immediate again after the batch update
+    m_first->setValue(4);
+
+    ASSERT_EQ(2, firstChanges);
+}
+
+TEST_F(PropertyGroup_test, BatchUpdateReportsChangesInOrder)
+{
+    auto calls = 0;
+    auto changes = std::vector<AbstractProperty *>();
+
+    m_group.valuesChanged.connect([&calls, &changes] (const std::vector<AbstractProperty *> & properties) {
+        ++calls;
+        changes = properties;
+    });
+
+    {
+        PropertyGroup::BatchUpdate batch(m_group);
+
+        m_third->setValue("third");
+        m_first->setValue(1);
+        m_third->setValue("again");
+    }
+
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ((std::vector<AbstractProperty *>{ m_third, m_first }), changes);
+
+    // No callback for a batch update without changes
+    {
+        PropertyGroup::BatchUpdate batch(m_group);
+    }
+
+    ASSERT_EQ(1, calls);
+}
+
+TEST_F(PropertyGroup_test, NestedBatchUpdatesNotifyWithOutermost)
+{
+    auto groupCalls = 0;
+    auto subCalls = 0;
+    auto firstChanges = 0;
+    auto thirdChanges = 0;
+
+    m_group.valuesChanged.connect([&groupCalls] (const std::vector<AbstractProperty *> &) { ++groupCalls; });
+    m_sub->valuesChanged.connect([&subCalls] (const std::vector<AbstractProperty *> &) { ++subCalls; });
+    m_first->changed.connect([&firstChanges] () { ++firstChanges; });
+    m_third->changed.connect([&thirdChanges] () { ++thirdChanges; });
+
+    {
+        PropertyGroup::BatchUpdate outer(m_group);
+
+        m_first->setValue(1);
+
+        {
+            PropertyGroup::BatchUpdate inner(*m_sub);
+            m_third->setValue("third");
+        }
+
+        ASSERT_EQ(0, subCalls);
+        ASSERT_EQ(0, thirdChanges);
+    }
+
+    ASSERT_EQ(1, groupCalls);
+    ASSERT_EQ(0, subCalls);
+    ASSERT_EQ(1, firstChanges);
+    ASSERT_EQ(1, thirdChanges);
+}
+
+TEST_F(PropertyGroup_test, FromVariantNotifiesOnce)
+{
+    auto calls = 0;
+    auto changes = std::vector<AbstractProperty *>();
+    auto firstChanges = 0;
+    auto notifyingBatch = false;
+
+    m_group.valuesChanged.connect([&calls, &changes] (const std::vector<AbstractProperty *> & properties) {
+        ++calls;
+        changes = properties;
+    });
+    m_first->changed.connect([this, &firstChanges, &notifyingBatch] () {
+        ++firstChanges;
+        notifyingBatch = m_group.isNotifyingBatch();
+    });
+
+    Variant values = Variant::map();
+    (*values.asMap())["first"] = 1;
+    (*values.asMap())["second"] = 2;
+
+    Variant subValues = Variant::map();
+    (*subValues.asMap())["third"] = std::string("third");
+    (*values.asMap())["sub"] = subValues;
+
+    ASSERT_TRUE(m_group.fromVariant(values));
+
+    ASSERT_EQ(1, m_first->value());
+    ASSERT_EQ(2, m_second->value());
+    ASSERT_EQ("third", m_third->value());
+
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(3u, changes.size());
+    ASSERT_EQ(1, firstChanges);
+    ASSERT_TRUE(notifyingBatch);
+    ASSERT_FALSE(m_group.isNotifyingBatch());
+}
+
+TEST_F(PropertyGroup_test, BatchUpdateCoversArrayElements)
+{
+    auto array = m_group.addProperty<std::array<int, 3>>("array", new ArrayAccessorValue<int, 3>());
+
+    auto arrayChanges = 0;
+    array->changed.connect([&arrayChanges] () { ++arrayChanges; });
+
+    {
+        PropertyGroup::BatchUpdate batch(m_group);
+
+        array->setElement(0, 1);
+        array->setElement(2, 3);
+        array->at(1)->fromVariant(2);
+
+        ASSERT_EQ(0, arrayChanges);
+    }
+
+    ASSERT_EQ(1, arrayChanges);
+    ASSERT_EQ((std::array<int, 3>{{ 1, 2, 3 }}), array->value());
+}
+
+TEST_F(PropertyGroup_test, PropertyDeletedDuringBatchUpdateIsNotNotified)
+{
+    auto changes = std::vector<AbstractProperty *>();
+
+    m_group.valuesChanged.connect([&changes] (const std::vector<AbstractProperty *> & properties) {
+        changes = properties;
+    });
+
+    {
+        PropertyGroup::BatchUpdate batch(m_group);
+
+        m_first->setValue(1);
+        m_second->setValue(2);
+
+        delete m_group.takeProperty("first");
+    }
+
+    ASSERT_EQ((std::vector<AbstractProperty *>{ m_second }), changes);
+}
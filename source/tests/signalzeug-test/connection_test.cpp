@@ -0,0 +1,154 @@
+#include <gmock/gmock.h>
+
+#include <memory>
+
+#include <signalzeug/Connection.h>
+#include <signalzeug/Signal.h>
+
+
+using namespace signalzeug;
+
+class connection_test : public testing::Test
+{
+public:
+    connection_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(connection_test, Disconnect)
+{
+    Signal<int> signal;
+
+    auto sum = 0;
+
+    auto connection = signal.connect([&sum] (int value) { sum += value; });
+    ASSERT_NE(0u, connection.id());
+
+    signal.fire(1);
+    connection.disconnect();
+    signal.fire(2);
+
+    ASSERT_EQ(1, sum);
+
+    // Disconnecting again, or an unconnected connection, has no effect
+    connection.disconnect();
+    Connection().disconnect();
+}
+
+TEST_F(connection_test, StaleConnectionAfterReuse)
+{
+    Signal<> signal;
+
+    auto first = 0;
+    auto second = 0;
+
+    auto connection = signal.connect([&first] () { ++first; });
+    auto stale = connection;
+
+    connection.disconnect();
+
+    // Reuses the handle of the disconnected slot, with a new generation
+    auto reused = signal.connect([&second] () { ++second; });
+
+    ASSERT_EQ(stale.id() & 0xffffffffu, reused.id() & 0xffffffffu);
+    ASSERT_NE(stale.id(), reused.id());
+
+    stale.disconnect();
+    signal.fire();
+
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(1, second);
+
+    reused.disconnect();
+    signal.fire();
+
+    ASSERT_EQ(1, second);
+}
+
+TEST_F(connection_test, ConnectionOutlivesSignal)
+{
+    auto calls = 0;
+    Connection connection;
+
+    {
+        Signal<> signal;
+        connection = signal.connect([&calls] () { ++calls; });
+
+        signal.fire();
+    }
+
+    // Expired with the signal
+    connection.disconnect();
+
+    ASSERT_EQ(1, calls);
+
+    // Copies of the connection expire as well
+    auto signal = std::unique_ptr<Signal<>>(new Signal<>);
+    connection = signal->connect([&calls] () { ++calls; });
+
+    Connection outlived = connection;
+    signal.reset();
+    outlived.disconnect();
+
+    ASSERT_EQ(1, calls);
+}
+
+TEST_F(connection_test, CopiedSignal)
+{
+    Signal<int> signal;
+
+    auto original = 0;
+    auto copied = 0;
+
+    auto connection = signal.connect([&original] (int value) { original += value; });
+
+    Signal<int> copy(signal);
+
+    // The connection refers to the original signal only
+    connection.disconnect();
+
+    signal.fire(1);
+    copy.fire(2);
+
+    ASSERT_EQ(2, original);
+
+    // Connections to the copy use its own handles
+    auto copyConnection = copy.connect([&copied] (int value) { copied += value; });
+
+    signal.fire(4);
+    copy.fire(8);
+
+    ASSERT_EQ(10, original);
+    ASSERT_EQ(8, copied);
+
+    copyConnection.disconnect();
+    copy.fire(16);
+
+    ASSERT_EQ(26, original);
+    ASSERT_EQ(8, copied);
+}
+
+TEST_F(connection_test, DisconnectFromSlot)
+{
+    Signal<> signal;
+
+    auto calls = 0;
+    Connection connection;
+
+    connection = signal.connect([&calls, &connection] () {
+        ++calls;
+        connection.disconnect();
+    });
+
+    auto other = 0;
+    signal.connect([&other] () { ++other; });
+
+    signal.fire();
+    signal.fire();
+
+    ASSERT_EQ(1, calls);
+    ASSERT_EQ(2, other);
+}
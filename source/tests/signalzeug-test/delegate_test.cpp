@@ -0,0 +1,232 @@
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <signalzeug/Delegate.h>
+
+
+using namespace signalzeug;
+
+namespace
+{
+
+// Counts its live instances, to check that every one is destroyed exactly once
+template <size_t Padding, bool NothrowMove = true>
+struct Counted
+{
+    explicit Counted(int & live)
+    : live(&live)
+    {
+        ++*this->live;
+    }
+
+    Counted(const Counted & other)
+    : live(other.live)
+    {
+        ++*live;
+    }
+
+    Counted(Counted && other) noexcept(NothrowMove)
+    : live(other.live)
+    {
+        ++*live;
+    }
+
+    ~Counted()
+    {
+        --*live;
+    }
+
+    int operator()(int value) const
+    {
+        return value + static_cast<int>(Padding);
+    }
+
+    int * live;
+    char padding[Padding];
+};
+
+typedef Counted<1> Small;
+typedef Counted<Delegate<int(int)>::BufferSize> Large;
+typedef Counted<1, false> ThrowingMove;
+
+struct Target
+{
+    void set(int value)
+    {
+        this->value = value;
+    }
+
+    int get() const
+    {
+        return value;
+    }
+
+    int value;
+};
+
+// Copies, moves and assigns a delegate holding the callable
+template <typename Callable>
+void exercise(Callable callable, bool isInline)
+{
+    Delegate<int(int)> delegate(std::move(callable));
+    ASSERT_EQ(isInline, delegate.isInline());
+    const auto expected = delegate(1);
+
+    Delegate<int(int)> copy(delegate);
+    ASSERT_EQ(expected, copy(1));
+
+    Delegate<int(int)> moved(std::move(copy));
+    ASSERT_FALSE(static_cast<bool>(copy));
+    ASSERT_EQ(expected, moved(1));
+    ASSERT_EQ(isInline, moved.isInline());
+
+    Delegate<int(int)> assigned([] (int value) { return value; });
+    assigned = delegate;
+    ASSERT_EQ(expected, assigned(1));
+
+    assigned = std::move(moved);
+    ASSERT_FALSE(static_cast<bool>(moved));
+    ASSERT_EQ(expected, assigned(1));
+
+    assigned = assigned;
+    ASSERT_EQ(expected, assigned(1));
+
+    delegate = nullptr;
+    ASSERT_FALSE(static_cast<bool>(delegate));
+}
+
+} // namespace
+
+class delegate_test : public testing::Test
+{
+public:
+    delegate_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(delegate_test, Empty)
+{
+    Delegate<void()> delegate;
+
+    ASSERT_FALSE(static_cast<bool>(delegate));
+    ASSERT_TRUE(delegate.isInline());
+
+    Delegate<void()> copy(delegate);
+    ASSERT_FALSE(static_cast<bool>(copy));
+}
+
+TEST_F(delegate_test, InlineCallable)
+{
+    auto live = 0;
+
+    exercise(Small(live), true);
+
+    ASSERT_EQ(0, live);
+}
+
+TEST_F(delegate_test, HeapCallable)
+{
+    auto live = 0;
+
+    exercise(Large(live), false);
+
+    ASSERT_EQ(0, live);
+}
+
+TEST_F(delegate_test, ThrowingMoveOnHeap)
+{
+    auto live = 0;
+
+    exercise(ThrowingMove(live), false);
+
+    ASSERT_EQ(0, live);
+}
+
+TEST_F(delegate_test, TriviallyCopyableCallable)
+{
+    auto offset = 1;
+    auto callable = [&offset] (int value) { return value + offset; };
+
+    ASSERT_TRUE(std::is_trivially_copyable<decltype(callable)>::value);
+
+    exercise(callable, true);
+
+    Delegate<int(int)> delegate(callable);
+    Delegate<int(int)> copy(delegate);
+
+    offset = 2;
+    ASSERT_EQ(3, copy(1));
+}
+
+TEST_F(delegate_test, StdFunction)
+{
+    auto live = 0;
+
+    exercise(std::function<int(int)>(Large(live)),
+        std::is_nothrow_move_constructible<std::function<int(int)>>::value);
+
+    ASSERT_EQ(0, live);
+}
+
+TEST_F(delegate_test, AssignDifferentKinds)
+{
+    auto live = 0;
+
+    {
+        auto delegate = Delegate<int(int)>(Small(live));
+        auto large = Delegate<int(int)>(Large(live));
+        ASSERT_EQ(2, live);
+
+        delegate = large;
+        ASSERT_EQ(2, live);
+        ASSERT_FALSE(delegate.isInline());
+
+        large = Delegate<int(int)>(Small(live));
+        ASSERT_EQ(2, live);
+        ASSERT_TRUE(large.isInline());
+
+        std::swap(delegate, large);
+        ASSERT_EQ(2, live);
+        ASSERT_EQ(1 + static_cast<int>(Delegate<int(int)>::BufferSize), large(1));
+        ASSERT_EQ(2, delegate(1));
+    }
+
+    ASSERT_EQ(0, live);
+}
+
+TEST_F(delegate_test, BoundMethod)
+{
+    Target first = { 0 };
+    Target second = { 0 };
+
+    Delegate<void(int)> set(&first, &Target::set);
+    ASSERT_TRUE(set.isInline());
+
+    auto copy = set;
+    auto moved = std::move(copy);
+
+    set(1);
+    moved(2);
+
+    ASSERT_EQ(2, first.value);
+    ASSERT_EQ(0, second.value);
+
+    moved = Delegate<void(int)>(&second, &Target::set);
+    moved(3);
+
+    ASSERT_EQ(2, first.value);
+    ASSERT_EQ(3, second.value);
+
+    const Target & constant = second;
+    Delegate<int()> get(&constant, &Target::get);
+    Delegate<int()> getCopy(get);
+
+    second.value = 4;
+    ASSERT_EQ(4, getCopy());
+}
@@ -0,0 +1,135 @@
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include <signalzeug/EventQueue.h>
+#include <signalzeug/Signal.h>
+#include <signalzeug/ThreadSafeSignal.h>
+
+
+using namespace signalzeug;
+
+class event_queue_test : public testing::Test
+{
+public:
+    event_queue_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(event_queue_test, QueuedDelivery)
+{
+    EventQueue queue;
+    Signal<int> signal;
+
+    auto values = std::vector<int>();
+    signal.connect(queue, [&values] (int value) { values.push_back(value); });
+
+    signal.fire(1);
+    signal.fire(2);
+
+    ASSERT_TRUE(values.empty());
+    ASSERT_EQ(2u, queue.process());
+    ASSERT_EQ((std::vector<int>{ 1, 2 }), values);
+}
+
+TEST_F(event_queue_test, CoalescedDelivery)
+{
+    EventQueue queue;
+    Signal<int> signal;
+
+    auto values = std::vector<int>();
+    signal.connect(queue, [&values] (int value) { values.push_back(value); }, Delivery::Coalesced);
+
+    signal.fire(1);
+    signal.fire(2);
+    signal.fire(3);
+
+    ASSERT_EQ(1u, queue.process());
+    ASSERT_EQ((std::vector<int>{ 3 }), values);
+}
+
+TEST_F(event_queue_test, DisconnectDropsPendingEvents)
+{
+    EventQueue queue;
+    Signal<int> signal;
+
+    auto plain = 0;
+    auto queued = 0;
+
+    // Several slots, so that disconnecting does not compact the slots right away
+    signal.connect([&plain] (int) { ++plain; });
+    signal.connect([&plain] (int) { ++plain; });
+    signal.connect([&plain] (int) { ++plain; });
+
+    auto connection = signal.connect(queue, [&queued] (int) { ++queued; });
+
+    signal.fire(1);
+    connection.disconnect();
+    queue.process();
+
+    ASSERT_EQ(3, plain);
+    ASSERT_EQ(0, queued);
+}
+
+TEST_F(event_queue_test, DisconnectFromSlotDropsPendingEvents)
+{
+    EventQueue queue;
+    Signal<int> signal;
+
+    auto queued = 0;
+
+    auto connection = signal.connect(queue, [&queued] (int) { ++queued; });
+    signal.connect([&connection] (int) { connection.disconnect(); });
+
+    // Disconnected while the signal is firing
+    signal.fire(1);
+    queue.process();
+
+    ASSERT_EQ(0, queued);
+}
+
+TEST_F(event_queue_test, CopiedSignalKeepsOwnSlot)
+{
+    EventQueue queue;
+    Signal<int> signal;
+
+    auto values = std::vector<int>();
+
+    signal.connect([] (int) {});
+    auto connection = signal.connect(queue, [&values] (int value) { values.push_back(value); });
+
+    Signal<int> copy(signal);
+
+    signal.fire(1);
+    copy.fire(2);
+    connection.disconnect();
+    queue.process();
+
+    // The connection refers to the original signal only
+    ASSERT_EQ((std::vector<int>{ 2 }), values);
+}
+
+TEST_F(event_queue_test, ThreadSafeSignalDisconnectDropsPendingEvents)
+{
+    EventQueue queue;
+    ThreadSafeSignal<int> signal;
+
+    auto plain = 0;
+    auto queued = 0;
+
+    signal.connect([&plain] (int) { ++plain; });
+    signal.connect([&plain] (int) { ++plain; });
+    signal.connect([&plain] (int) { ++plain; });
+
+    auto connection = signal.connect(queue, [&queued] (int) { ++queued; });
+
+    signal.fire(1);
+    connection.disconnect();
+    queue.process();
+
+    ASSERT_EQ(3, plain);
+    ASSERT_EQ(0, queued);
+}
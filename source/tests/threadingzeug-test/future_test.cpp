@@ -0,0 +1,224 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <threadingzeug/Future.h>
+#include <threadingzeug/parallelfor.h>
+
+
+using namespace threadingzeug;
+
+class future_test : public testing::Test
+{
+public:
+    future_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(future_test, RunAsync)
+{
+    auto future = runAsync([] () { return 42; });
+
+    ASSERT_TRUE(future.valid());
+    ASSERT_EQ(42, future.get());
+    ASSERT_TRUE(future.isReady());
+
+    auto executed = false;
+    auto done = runAsync([&executed] () { executed = true; });
+
+    done.wait();
+    ASSERT_TRUE(executed);
+
+    ASSERT_FALSE(Future<int>().valid());
+}
+
+TEST_F(future_test, ThenChain)
+{
+    auto future = runAsync([] () { return 20; })
+        .then([] (int value) { return value + 1; })
+        .then([] (int value) { return std::to_string(value * 2); });
+
+    ASSERT_EQ("42", future.get());
+
+    std::atomic<int> calls(0);
+
+    auto chained = runAsync([&calls] () { ++calls; })
+        .then([&calls] () { ++calls; })
+        .then([&calls] () { return calls.load(); });
+
+    ASSERT_EQ(2, chained.get());
+}
+
+TEST_F(future_test, ThenOnReadyFuture)
+{
+    Promise<int> promise;
+    promise.setValue(7);
+
+    auto future = promise.future();
+    ASSERT_TRUE(future.isReady());
+
+    ASSERT_EQ(14, future.then([] (int value) { return value * 2; }).get());
+}
+
+TEST_F(future_test, WhenAll)
+{
+    auto futures = std::vector<Future<int>>();
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        futures.push_back(runAsync([i] () { return i * i; }));
+    }
+
+    const auto values = whenAll(futures).get();
+
+    ASSERT_EQ(100u, values.size());
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i * i, values[i]);
+    }
+
+    ASSERT_TRUE(whenAll(std::vector<Future<void>>()).isReady());
+}
+
+TEST_F(future_test, WhenAny)
+{
+    Promise<void> never;
+    Promise<void> soon;
+
+    auto any = whenAny(std::vector<Future<void>>{ never.future(), soon.future() });
+
+    ASSERT_FALSE(any.isReady());
+
+    soon.setValue();
+    ASSERT_EQ(1u, any.get());
+
+    never.setValue();
+    ASSERT_EQ(1u, any.get());
+}
+
+TEST_F(future_test, NestedWaitDoesNotDeadlock)
+{
+    // More nested waits than workers; waiting helps executing pending tasks
+    auto outer = std::vector<Future<int>>();
+
+    for (auto i = 0; i < 16; ++i)
+    {
+        outer.push_back(runAsync([i] () {
+            auto inner = runAsync([i] () { return i; });
+            return inner.get() + 1;
+        }));
+    }
+
+    auto sum = 0;
+
+    for (const auto & future : outer)
+    {
+        sum += future.get();
+    }
+
+    ASSERT_EQ(136, sum);
+}
+
+TEST_F(future_test, ParallelForAsync)
+{
+    const auto size = static_cast<size_t>(100000);
+
+    auto a = std::vector<int>(size, 0);
+    auto b = std::vector<int>(size, 0);
+
+    for (auto schedule : { Schedule::Static, Schedule::StaticChunked, Schedule::Dynamic, Schedule::Guided })
+    {
+        auto first = parallelForAsync<size_t>(0, size, [&a] (size_t i) { ++a[i]; }, schedule, 64);
+        auto second = parallelForAsync(b, [] (int & value) { value += 2; }, schedule, 64);
+
+        whenAll(std::vector<Future<void>>{ first, second }).wait();
+    }
+
+    for (auto i = static_cast<size_t>(0); i < size; ++i)
+    {
+        ASSERT_EQ(4, a[i]);
+        ASSERT_EQ(8, b[i]);
+    }
+
+    ASSERT_TRUE(parallelForAsync(5, 5, [] (int) {}).isReady());
+}
+
+TEST_F(future_test, Exceptions)
+{
+    auto failing = runAsync([] () -> int { throw std::runtime_error("failed"); });
+
+    ASSERT_THROW(failing.get(), std::runtime_error);
+    ASSERT_TRUE(failing.isReady());
+
+    // Continuations are skipped and pass the exception on
+    auto called = false;
+    auto continued = failing.then([&called] (int value) { called = true; return value; });
+    ASSERT_THROW(continued.get(), std::runtime_error);
+
+    auto failingVoid = runAsync([] () { throw std::logic_error("failed"); });
+    auto continuedVoid = failingVoid.then([&called] () { called = true; });
+    ASSERT_THROW(continuedVoid.get(), std::logic_error);
+    ASSERT_FALSE(called);
+
+    auto throwingContinuation = runAsync([] () { return 1; }).then([] (int) -> int { throw std::runtime_error("failed"); });
+    ASSERT_THROW(throwingContinuation.get(), std::runtime_error);
+
+    ASSERT_THROW(whenAll(std::vector<Future<int>>{ runAsync([] () { return 1; }), failing }).get(), std::runtime_error);
+    ASSERT_THROW(whenAll(std::vector<Future<void>>{ failingVoid }).get(), std::logic_error);
+
+    Promise<int> promise;
+    promise.setException(std::make_exception_ptr(std::out_of_range("failed")));
+    ASSERT_THROW(promise.future().get(), std::out_of_range);
+
+    auto loop = parallelForAsync(0, 1000, [] (int i) {
+        if (i == 500)
+            throw std::runtime_error("failed");
+    }, Schedule::Dynamic, 16);
+    ASSERT_THROW(loop.get(), std::runtime_error);
+}
+
+TEST_F(future_test, BrokenPromise)
+{
+    auto future = Future<int>();
+
+    {
+        Promise<int> promise;
+        future = promise.future();
+
+        // Copies share the result; the promise is broken with the last one
+        auto copy = promise;
+        ASSERT_FALSE(future.isReady());
+    }
+
+    ASSERT_TRUE(future.isReady());
+
+    try
+    {
+        future.get();
+        FAIL();
+    }
+    catch (const std::future_error & error)
+    {
+        ASSERT_EQ(std::make_error_code(std::future_errc::broken_promise), error.code());
+    }
+
+    auto fulfilled = Future<int>();
+
+    {
+        Promise<int> promise;
+        fulfilled = promise.future();
+        promise.setValue(3);
+    }
+
+    ASSERT_EQ(3, fulfilled.get());
+}
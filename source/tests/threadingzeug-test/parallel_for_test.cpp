@@ -1,8 +1,14 @@
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <utility>
 
 #include <threadingzeug/parallelfor.h>
+#include <threadingzeug/ThreadPool.h>
 
 
 using namespace threadingzeug;
@@ -190,3 +196,238 @@ TEST_F(parallelFor_test, IntCompilation)
     });
 }
 */
+
+TEST_F(parallelFor_test, SchedulesVisitEachIterationOnce)
+{
+    const auto schedules = std::vector<Schedule>{ Schedule::Static, Schedule::StaticChunked, Schedule::Dynamic, Schedule::Guided };
+    const auto grainSizes = std::vector<size_t>{ 0, 1, 3, 64, 1000 };
+
+    for (auto schedule : schedules)
+    {
+        for (auto grainSize : grainSizes)
+        {
+            for (auto count : { 0u, 1u, 2u, 7u, 100u, 1001u })
+            {
+                auto visits = std::vector<std::atomic<int>>(count + 10);
+
+                for (auto & visit : visits)
+                {
+                    visit = 0;
+                }
+
+                parallelFor<unsigned int>(5, 5 + count, [&visits] (unsigned int i) {
+                    ++visits[i];
+                }, schedule, grainSize);
+
+                for (auto i = 0u; i < visits.size(); ++i)
+                {
+                    ASSERT_EQ(i >= 5 && i < 5 + count ? 1 : 0, visits[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(parallelFor_test, SignedRange)
+{
+    auto visits = std::vector<std::atomic<int>>(20);
+
+    for (auto & visit : visits)
+    {
+        visit = 0;
+    }
+
+    parallelFor<int>(-10, 10, [&visits] (int i) {
+        ++visits[i + 10];
+    }, Schedule::Dynamic, 3);
+
+    for (const auto & visit : visits)
+    {
+        ASSERT_EQ(1, visit);
+    }
+}
+
+TEST_F(parallelFor_test, CountAboveFloatPrecision)
+{
+    // 2^24 + 3 iterations cannot be split exactly with single precision floats
+    const auto count = (static_cast<size_t>(1) << 24) + 3;
+    auto visited = std::vector<char>(count, 0);
+
+    parallelFor<size_t>(0, count, [&visited] (size_t i) {
+        visited[i] = 1;
+    });
+
+    ASSERT_EQ(count, static_cast<size_t>(std::count(visited.begin(), visited.end(), 1)));
+}
+
+TEST_F(parallelFor_test, StdFunctionAndTemplateCallablesAgree)
+{
+    const auto count = 1000u;
+    auto vec1 = std::vector<int>(count, 0);
+    auto vec2 = std::vector<int>(count, 0);
+
+    const auto function = std::function<void(unsigned int)>([&vec1] (unsigned int i) {
+        vec1[i] = static_cast<int>(i * 2);
+    });
+
+    parallelFor(0u, count, function);
+
+    parallelFor(0u, count, [&vec2] (unsigned int i) {
+        vec2[i] = static_cast<int>(i * 2);
+    });
+
+    ASSERT_EQ(vec1, vec2);
+}
+
+TEST_F(parallelFor_test, VectorOverloads)
+{
+    auto vec = std::vector<int>(100, 1);
+
+    parallelFor(vec, [] (int & element) {
+        element *= 3;
+    });
+
+    std::atomic<int> sum(0);
+
+    parallelFor(static_cast<const std::vector<int> &>(vec), [&sum] (const int & element) {
+        sum += element;
+    });
+
+    ASSERT_EQ(300, sum);
+
+    auto sequentialSum = 0;
+
+    sequentialFor(vec, std::function<void(int &)>([&sequentialSum] (int & element) {
+        sequentialSum += element;
+    }));
+
+    ASSERT_EQ(300, sequentialSum);
+}
+
+namespace
+{
+
+template <typename T>
+void expectContiguousSplit(T start, T end, size_t grainSize, Schedule schedule)
+{
+    std::mutex mutex;
+    auto ranges = std::vector<std::pair<T, T>>();
+
+    parallelForRange(start, end, grainSize, [&mutex, &ranges] (T begin, T end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.emplace_back(begin, end);
+    }, schedule);
+
+    std::sort(ranges.begin(), ranges.end());
+
+    auto expectedBegin = start;
+
+    for (const auto & range : ranges)
+    {
+        ASSERT_EQ(expectedBegin, range.first);
+        ASSERT_LT(range.first, range.second);
+
+        if (schedule != Schedule::Static)
+        {
+            ASSERT_LE(static_cast<size_t>(range.second - range.first), std::max(grainSize, static_cast<size_t>(1)));
+        }
+
+        expectedBegin = range.second;
+    }
+
+    ASSERT_EQ(start < end ? end : start, expectedBegin);
+}
+
+} // namespace
+
+TEST_F(parallelFor_test, RangeBoundarySplits)
+{
+    const auto schedules = std::vector<Schedule>{ Schedule::Static, Schedule::StaticChunked, Schedule::Dynamic };
+
+    for (auto schedule : schedules)
+    {
+        for (auto grainSize = static_cast<size_t>(0); grainSize <= 9; ++grainSize)
+        {
+            for (auto count = 0u; count <= 40; ++count)
+            {
+                expectContiguousSplit<unsigned int>(3u, 3u + count, grainSize, schedule);
+                expectContiguousSplit<int>(-20, -20 + static_cast<int>(count), grainSize, schedule);
+            }
+        }
+    }
+
+    // Guided chunks may exceed the grain size, but must still tile the range
+    for (auto count = 0u; count <= 200; ++count)
+    {
+        std::mutex mutex;
+        auto total = static_cast<size_t>(0);
+
+        parallelForRange<size_t>(0, count, 4, [&mutex, &total] (size_t begin, size_t end) {
+            std::lock_guard<std::mutex> lock(mutex);
+            total += end - begin;
+        }, Schedule::Guided);
+
+        ASSERT_EQ(count, total);
+    }
+
+    // Empty and reversed ranges do not invoke the callback
+    parallelForRange(5, 5, 1, [] (int, int) { FAIL(); });
+    parallelForRange(5, 2, 1, [] (int, int) { FAIL(); });
+}
+
+TEST_F(parallelFor_test, NestedLoopsStayWithinWorkers)
+{
+    auto & pool = ThreadPool::instance();
+    const auto numberOfWorkers = pool.numberOfWorkers();
+
+    pool.setNumberOfWorkers(4);
+
+    const auto outer = 6, middle = 5, inner = 40;
+
+    auto visits = std::vector<std::atomic<int>>(outer * middle * inner);
+
+    std::mutex mutex;
+    auto threads = std::set<std::thread::id>();
+
+    const auto body = [&] (int i, int j, int k) {
+        ++visits[(i * middle + j) * inner + k];
+
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    };
+
+    // Three levels of nesting, started from the calling thread and from within pool tasks
+    for (auto async : { false, true })
+    {
+        threads.clear();
+
+        const auto nested = [&] () {
+            parallelFor(0, outer, [&] (int i) {
+                parallelFor(0, middle, [&] (int j) {
+                    parallelFor(0, inner, [&] (int k) {
+                        body(i, j, k);
+                    }, Schedule::Dynamic);
+                });
+            });
+        };
+
+        if (async)
+        {
+            parallelForAsync(0, 1, [&nested] (int) { nested(); }).wait();
+        }
+        else
+        {
+            nested();
+        }
+
+        // All workers plus the calling thread at most (or the OpenMP team of the top level loop)
+        ASSERT_LE(threads.size(), std::max(pool.numberOfWorkers() + 1, getNumberOfThreads()));
+    }
+
+    for (const auto & count : visits)
+    {
+        ASSERT_EQ(2, count);
+    }
+
+    pool.setNumberOfWorkers(numberOfWorkers);
+}
@@ -0,0 +1,121 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <threadingzeug/parallelreduce.h>
+#include <threadingzeug/ThreadPool.h>
+
+
+using namespace threadingzeug;
+
+class parallelReduce_test : public testing::Test
+{
+public:
+    parallelReduce_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(parallelReduce_test, EmptyRangeYieldsIdentity)
+{
+    const auto result = parallelTransformReduce<size_t>(3, 3, 42, [] (size_t i) { return static_cast<int>(i); }, std::plus<int>());
+
+    ASSERT_EQ(42, result);
+}
+
+TEST_F(parallelReduce_test, SumMatchesSequential)
+{
+    for (auto count : { 1u, 1023u, 1024u, 1025u, 100000u, 1234567u })
+    {
+        auto elements = std::vector<std::uint64_t>(count);
+        std::iota(elements.begin(), elements.end(), 1);
+
+        const auto expected = std::accumulate(elements.begin(), elements.end(), static_cast<std::uint64_t>(0));
+
+        ASSERT_EQ(expected, parallelReduce(elements, static_cast<std::uint64_t>(0), std::plus<std::uint64_t>()));
+    }
+}
+
+TEST_F(parallelReduce_test, MinMax)
+{
+    auto elements = std::vector<int>(500000);
+
+    for (auto i = static_cast<size_t>(0); i < elements.size(); ++i)
+    {
+        elements[i] = static_cast<int>((i * 7919) % 100003) - 50000;
+    }
+
+    const auto minimum = parallelReduce(elements, elements.front(), [] (int a, int b) { return std::min(a, b); });
+    const auto maximum = parallelReduce(elements, elements.front(), [] (int a, int b) { return std::max(a, b); });
+
+    ASSERT_EQ(*std::min_element(elements.begin(), elements.end()), minimum);
+    ASSERT_EQ(*std::max_element(elements.begin(), elements.end()), maximum);
+}
+
+TEST_F(parallelReduce_test, TransformReduceOverVector)
+{
+    auto elements = std::vector<int>(10000, 3);
+
+    const auto sumOfSquares = parallelTransformReduce(elements, static_cast<long long>(0),
+        [] (int element) { return static_cast<long long>(element) * element; },
+        std::plus<long long>());
+
+    ASSERT_EQ(90000, sumOfSquares);
+}
+
+TEST_F(parallelReduce_test, Histogram)
+{
+    const auto count = static_cast<size_t>(300000);
+
+    const auto histogram = parallelReduce<size_t>(0, count, std::vector<size_t>(16, 0),
+        [] (size_t begin, size_t end, std::vector<size_t> partial) {
+            for (auto i = begin; i < end; ++i)
+            {
+                ++partial[i % 16];
+            }
+
+            return partial;
+        },
+        [] (std::vector<size_t> a, const std::vector<size_t> & b) {
+            for (auto i = static_cast<size_t>(0); i < a.size(); ++i)
+            {
+                a[i] += b[i];
+            }
+
+            return a;
+        });
+
+    for (const auto bin : histogram)
+    {
+        ASSERT_EQ(count / 16, bin);
+    }
+}
+
+TEST_F(parallelReduce_test, FloatingPointSumIsReproducible)
+{
+    const auto count = static_cast<size_t>(1000000);
+    const auto value = [] (size_t i) { return 1.0f / static_cast<float>(i + 1); };
+
+    auto & pool = ThreadPool::instance();
+    const auto numberOfWorkers = pool.numberOfWorkers();
+
+    const auto first = parallelTransformReduce<size_t>(0, count, 0.0f, value, std::plus<float>());
+
+    pool.setNumberOfWorkers(numberOfWorkers + 3);
+    const auto second = parallelTransformReduce<size_t>(0, count, 0.0f, value, std::plus<float>());
+
+    pool.setNumberOfWorkers(1);
+    const auto third = parallelTransformReduce<size_t>(0, count, 0.0f, value, std::plus<float>());
+
+    pool.setNumberOfWorkers(numberOfWorkers);
+
+    // Bitwise equality is intended
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(first, third);
+}
@@ -0,0 +1,110 @@
+#include <gmock/gmock.h>
+
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <threadingzeug/parallelscan.h>
+
+
+using namespace threadingzeug;
+
+class parallelScan_test : public testing::Test
+{
+public:
+    parallelScan_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(parallelScan_test, InclusiveMatchesPartialSum)
+{
+    for (auto count : { 0u, 1u, 1023u, 1024u, 1025u, 5000u, 300001u })
+    {
+        auto input = std::vector<long long>(count);
+
+        for (auto i = static_cast<size_t>(0); i < input.size(); ++i)
+        {
+            input[i] = static_cast<long long>(i % 13) - 6;
+        }
+
+        auto expected = std::vector<long long>(count);
+        std::partial_sum(input.begin(), input.end(), expected.begin());
+
+        auto output = std::vector<long long>(count);
+        const auto end = parallelInclusiveScan(input.begin(), input.end(), output.begin(), std::plus<long long>());
+
+        ASSERT_EQ(output.end(), end);
+        ASSERT_EQ(expected, output);
+    }
+}
+
+TEST_F(parallelScan_test, ExclusiveMatchesShiftedPartialSum)
+{
+    for (auto count : { 0u, 1u, 1023u, 1024u, 1025u, 5000u, 300001u })
+    {
+        auto input = std::vector<int>(count, 2);
+
+        auto expected = std::vector<int>(count);
+
+        for (auto i = static_cast<size_t>(0); i < count; ++i)
+        {
+            expected[i] = 10 + 2 * static_cast<int>(i);
+        }
+
+        auto output = std::vector<int>(count);
+        const auto end = parallelExclusiveScan(input.begin(), input.end(), output.begin(), 10, std::plus<int>());
+
+        ASSERT_EQ(output.end(), end);
+        ASSERT_EQ(expected, output);
+    }
+}
+
+TEST_F(parallelScan_test, InPlace)
+{
+    const auto count = 100000;
+
+    auto inclusive = std::vector<int>(count, 1);
+    parallelInclusiveScan(inclusive.begin(), inclusive.end(), inclusive.begin(), std::plus<int>());
+
+    auto exclusive = std::vector<int>(count, 1);
+    parallelExclusiveScan(exclusive.data(), exclusive.data() + count, exclusive.data(), 0, std::plus<int>());
+
+    for (auto i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(i + 1, inclusive[i]);
+        ASSERT_EQ(i, exclusive[i]);
+    }
+}
+
+TEST_F(parallelScan_test, StreamCompaction)
+{
+    const auto count = 50000;
+
+    auto values = std::vector<int>(count);
+    std::iota(values.begin(), values.end(), 0);
+
+    auto flags = std::vector<int>(count);
+
+    for (auto i = 0; i < count; ++i)
+    {
+        flags[i] = values[i] % 3 == 0 ? 1 : 0;
+    }
+
+    auto positions = std::vector<int>(count);
+    parallelExclusiveScan(flags.begin(), flags.end(), positions.begin(), 0, std::plus<int>());
+
+    auto compacted = std::vector<int>(positions.back() + flags.back());
+
+    parallelFor(0, count, [&] (int i) {
+        if (flags[i])
+            compacted[positions[i]] = values[i];
+    });
+
+    for (auto i = static_cast<size_t>(0); i < compacted.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<int>(i) * 3, compacted[i]);
+    }
+}
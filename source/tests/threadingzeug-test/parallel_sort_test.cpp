@@ -0,0 +1,140 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+#include <threadingzeug/parallelsort.h>
+#include <threadingzeug/ThreadPool.h>
+
+
+using namespace threadingzeug;
+
+class parallelSort_test : public testing::Test
+{
+public:
+    parallelSort_test()
+    : m_numberOfWorkers(ThreadPool::instance().numberOfWorkers())
+    , m_numberOfOpenMPThreads(0)
+    {
+    }
+
+protected:
+    // Use several threads independent of the machine so that blocks are actually merged
+    virtual void SetUp() override
+    {
+        ThreadPool::instance().setNumberOfWorkers(4);
+        setNumberOfThreads(4);
+#ifdef USE_OPENMP
+        m_numberOfOpenMPThreads = omp_get_max_threads();
+        omp_set_num_threads(4);
+#endif
+    }
+
+    virtual void TearDown() override
+    {
+        ThreadPool::instance().setNumberOfWorkers(m_numberOfWorkers);
+        setNumberOfThreads(0);
+#ifdef USE_OPENMP
+        omp_set_num_threads(m_numberOfOpenMPThreads);
+#endif
+    }
+
+    static std::vector<int> randomValues(size_t count, int maximum)
+    {
+        auto generator = std::mt19937(static_cast<unsigned int>(count));
+        auto distribution = std::uniform_int_distribution<int>(0, maximum);
+
+        auto values = std::vector<int>(count);
+
+        for (auto & value : values)
+        {
+            value = distribution(generator);
+        }
+
+        return values;
+    }
+
+protected:
+    size_t m_numberOfWorkers;
+    int m_numberOfOpenMPThreads;
+};
+
+TEST_F(parallelSort_test, SortMatchesStdSort)
+{
+    const auto counts = std::vector<size_t>{ 0, 1, 2, parallelSortThreshold - 1, parallelSortThreshold, 3 * parallelSortThreshold + 7, 1000003 };
+
+    for (const auto count : counts)
+    {
+        auto values = randomValues(count, 1000000);
+        auto expected = values;
+
+        std::sort(expected.begin(), expected.end());
+        parallelSort(values.begin(), values.end());
+
+        ASSERT_EQ(expected, values);
+    }
+}
+
+TEST_F(parallelSort_test, SortWithComparator)
+{
+    auto values = randomValues(500000, 100);
+    auto expected = values;
+
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    parallelSort(values.data(), values.data() + values.size(), std::greater<int>());
+
+    ASSERT_EQ(expected, values);
+
+    auto sequential = randomValues(500000, 100);
+    parallelSort(sequential.begin(), sequential.end(), std::greater<int>(), false);
+
+    ASSERT_EQ(expected, sequential);
+}
+
+TEST_F(parallelSort_test, StableSortPreservesOrderOfEquivalentElements)
+{
+    for (const auto count : { static_cast<size_t>(100), 5 * parallelSortThreshold + 3, static_cast<size_t>(400000) })
+    {
+        const auto keys = randomValues(count, 50);
+
+        auto values = std::vector<std::pair<int, size_t>>(count);
+
+        for (auto i = static_cast<size_t>(0); i < count; ++i)
+        {
+            values[i] = std::make_pair(keys[i], i);
+        }
+
+        const auto byKey = [] (const std::pair<int, size_t> & a, const std::pair<int, size_t> & b) { return a.first < b.first; };
+
+        auto expected = values;
+
+        std::stable_sort(expected.begin(), expected.end(), byKey);
+        parallelStableSort(values.begin(), values.end(), byKey);
+
+        ASSERT_EQ(expected, values);
+    }
+}
+
+TEST_F(parallelSort_test, PartitionIsStable)
+{
+    for (const auto count : { static_cast<size_t>(10), 2 * parallelSortThreshold + 1, static_cast<size_t>(777777) })
+    {
+        const auto isEven = [] (int value) { return value % 2 == 0; };
+
+        auto values = randomValues(count, 1000);
+        auto expected = values;
+
+        const auto expectedPoint = std::stable_partition(expected.begin(), expected.end(), isEven);
+        const auto point = parallelPartition(values.begin(), values.end(), isEven);
+
+        ASSERT_EQ(expectedPoint - expected.begin(), point - values.begin());
+        ASSERT_EQ(expected, values);
+    }
+}
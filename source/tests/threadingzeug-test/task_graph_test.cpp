@@ -0,0 +1,124 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <threadingzeug/TaskGraph.h>
+
+
+using namespace threadingzeug;
+
+class taskGraph_test : public testing::Test
+{
+public:
+    taskGraph_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(taskGraph_test, RunsEveryTaskAfterItsPredecessors)
+{
+    TaskGraph graph;
+
+    std::mutex mutex;
+    auto order = std::vector<TaskGraph::TaskId>();
+
+    const auto log = [&mutex, &order] (TaskGraph::TaskId id) {
+        return [&mutex, &order, id] () {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+
+    // Diamond: a -> (b, c) -> d
+    const auto a = graph.addTask("a", log(0));
+    const auto b = graph.addTask("b", log(1), { a });
+    const auto c = graph.addTask("c", log(2), { a });
+    const auto d = graph.addTask("d", log(3), { b, c });
+
+    ASSERT_EQ(4u, graph.size());
+    ASSERT_FALSE(graph.hasCycle());
+    ASSERT_TRUE(graph.run());
+
+    ASSERT_EQ(4u, order.size());
+    ASSERT_EQ(a, order.front());
+    ASSERT_EQ(d, order.back());
+
+    for (auto task : { a, b, c, d })
+    {
+        for (auto predecessor : graph.predecessors(task))
+        {
+            ASSERT_LE(graph.timing(predecessor).end, graph.timing(task).start);
+        }
+    }
+}
+
+TEST_F(taskGraph_test, WideGraph)
+{
+    TaskGraph graph;
+
+    std::atomic<int> count(0);
+
+    const auto root = graph.addTask("root", [] () {});
+
+    auto leaves = std::vector<TaskGraph::TaskId>();
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        leaves.push_back(graph.addTask("leaf", [&count] () { ++count; }, { root }));
+    }
+
+    auto sum = 0;
+    graph.addTask("sum", [&count, &sum] () { sum = count; }, leaves);
+
+    ASSERT_TRUE(graph.run());
+    ASSERT_EQ(1000, sum);
+
+    // Graphs can be run repeatedly
+    ASSERT_TRUE(graph.run());
+    ASSERT_EQ(2000, sum);
+}
+
+TEST_F(taskGraph_test, CycleIsRejected)
+{
+    TaskGraph graph;
+
+    auto executed = false;
+
+    const auto a = graph.addTask("a", [&executed] () { executed = true; });
+    const auto b = graph.addTask("b", [&executed] () { executed = true; }, { a });
+    graph.addDependency(a, b);
+
+    ASSERT_TRUE(graph.hasCycle());
+    ASSERT_FALSE(graph.run());
+    ASSERT_FALSE(executed);
+    ASSERT_TRUE(graph.criticalPath().empty());
+}
+
+TEST_F(taskGraph_test, CriticalPath)
+{
+    TaskGraph graph;
+
+    const auto sleep = [] (int milliseconds) {
+        return [milliseconds] () { std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds)); };
+    };
+
+    const auto a = graph.addTask("a", sleep(5));
+    const auto fast = graph.addTask("fast", sleep(1), { a });
+    const auto slow = graph.addTask("slow", sleep(30), { a });
+    const auto d = graph.addTask("d", sleep(5), { fast, slow });
+
+    ASSERT_TRUE(graph.run());
+
+    ASSERT_EQ(std::vector<TaskGraph::TaskId>({ a, slow, d }), graph.criticalPath());
+    ASSERT_EQ("slow", graph.name(graph.criticalPath()[1]));
+
+    ASSERT_GE(graph.duration(slow), std::chrono::milliseconds(30));
+    ASSERT_GE(graph.criticalPathDuration(), std::chrono::milliseconds(40));
+    ASSERT_GE(graph.totalDuration(), graph.criticalPathDuration());
+}
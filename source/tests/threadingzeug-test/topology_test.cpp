@@ -0,0 +1,138 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <threadingzeug/parallelfor.h>
+#include <threadingzeug/TaskGroup.h>
+#include <threadingzeug/ThreadPool.h>
+#include <threadingzeug/Topology.h>
+
+
+using namespace threadingzeug;
+
+class topology_test : public testing::Test
+{
+public:
+    topology_test()
+    : m_topology(Topology::current())
+    {
+    }
+
+protected:
+    virtual void TearDown() override
+    {
+        Topology::setCurrent(m_topology);
+    }
+
+protected:
+    Topology m_topology;
+};
+
+TEST_F(topology_test, ParseCpuList)
+{
+    ASSERT_EQ(std::vector<size_t>({ 0, 1, 2, 3, 8, 10, 11 }), Topology::parseCpuList("0-3,8,10-11\n"));
+    ASSERT_EQ(std::vector<size_t>({ 5 }), Topology::parseCpuList("5"));
+    ASSERT_TRUE(Topology::parseCpuList("").empty());
+}
+
+TEST_F(topology_test, DiscoveredTopologyIsConsistent)
+{
+    const auto topology = Topology::discover();
+
+    ASSERT_FALSE(topology.cpus().empty());
+    ASSERT_FALSE(topology.nodes().empty());
+    ASSERT_GE(topology.numberOfThreads(), 1u);
+    ASSERT_LE(topology.numberOfThreads(), topology.cpus().size());
+
+    // Every CPU belongs to the affinity mask and to exactly one node
+    auto nodeCpus = std::vector<size_t>();
+
+    for (const auto & node : topology.nodes())
+    {
+        nodeCpus.insert(nodeCpus.end(), node.cpus.begin(), node.cpus.end());
+    }
+
+    std::sort(nodeCpus.begin(), nodeCpus.end());
+
+    ASSERT_TRUE(std::adjacent_find(nodeCpus.begin(), nodeCpus.end()) == nodeCpus.end());
+    ASSERT_TRUE(std::includes(topology.cpus().begin(), topology.cpus().end(), nodeCpus.begin(), nodeCpus.end()));
+}
+
+TEST_F(topology_test, QuotaLimitsNumberOfThreads)
+{
+    auto cpus = std::vector<size_t>();
+
+    for (auto i = static_cast<size_t>(0); i < 64; ++i)
+    {
+        cpus.push_back(i);
+    }
+
+    auto topology = Topology(cpus, { Topology::Node{ 0, cpus } });
+    ASSERT_EQ(64u, topology.numberOfThreads());
+
+    topology.setCpuQuota(4.0);
+    ASSERT_EQ(4u, topology.numberOfThreads());
+
+    topology.setCpuQuota(2.5);
+    ASSERT_EQ(3u, topology.numberOfThreads());
+
+    topology.setCpuQuota(0.1);
+    ASSERT_EQ(1u, topology.numberOfThreads());
+
+    Topology::setCurrent(topology);
+    ASSERT_EQ(1u, getNumberOfThreads());
+
+    setNumberOfThreads(6);
+    ASSERT_EQ(6u, getNumberOfThreads());
+
+    setNumberOfThreads(0);
+    ASSERT_EQ(1u, getNumberOfThreads());
+}
+
+TEST_F(topology_test, Pinning)
+{
+    const auto cpus = m_topology.cpus();
+
+    // Two nodes made up from the available CPUs (a single CPU may appear in both)
+    const auto half = std::max(static_cast<size_t>(1), cpus.size() / 2);
+    const auto first = std::vector<size_t>(cpus.begin(), cpus.begin() + half);
+    const auto second = std::vector<size_t>(cpus.end() - half, cpus.end());
+
+    Topology::setCurrent(Topology(cpus, { Topology::Node{ 0, first }, Topology::Node{ 1, second } }));
+
+    ThreadPool pool(4, ThreadPool::Pinning::Node);
+
+    ASSERT_EQ(first, pool.workerCpus(0));
+    ASSERT_EQ(first, pool.workerCpus(1));
+    ASSERT_EQ(second, pool.workerCpus(2));
+    ASSERT_EQ(second, pool.workerCpus(3));
+
+    pool.setPinning(ThreadPool::Pinning::Cpu);
+
+    for (auto i = static_cast<size_t>(0); i < 4; ++i)
+    {
+        const auto & node = i < 2 ? first : second;
+
+        ASSERT_EQ(1u, pool.workerCpus(i).size());
+        ASSERT_EQ(node[(i % 2) % node.size()], pool.workerCpus(i).front());
+    }
+
+    // Pinned workers still execute tasks
+    std::atomic<int> count(0);
+
+    {
+        TaskGroup group(pool);
+
+        for (auto i = 0; i < 100; ++i)
+        {
+            group.run([&count] () { ++count; });
+        }
+    }
+
+    ASSERT_EQ(100, count);
+
+    pool.setPinning(ThreadPool::Pinning::None);
+    ASSERT_TRUE(pool.workerCpus(0).empty());
+}
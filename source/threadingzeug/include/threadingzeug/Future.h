@@ -0,0 +1,261 @@
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <threadingzeug/threadingzeug_api.h>
+
+
+namespace threadingzeug
+{
+
+
+class ThreadPool;
+
+template <typename T>
+class Future;
+
+
+namespace detail
+{
+
+
+// Completion state shared by all future types; continuations are executed on the pool
+class THREADINGZEUG_API FutureStateBase
+{
+public:
+    explicit FutureStateBase(ThreadPool & pool);
+
+    FutureStateBase(const FutureStateBase &) = delete;
+    FutureStateBase & operator=(const FutureStateBase &) = delete;
+
+    ThreadPool & pool() const;
+
+    bool isReady() const;
+
+    // Helps executing pending tasks of the pool until the state is ready
+    void wait() const;
+
+    // Submits continuation to the pool once the state is ready (immediately if it already is)
+    void then(std::function<void()> continuation);
+
+    // Completes the state with an exception that is rethrown by value()
+    void setException(std::exception_ptr exception);
+
+    // Completes the state with a broken promise error, unless it is already ready
+    void abandon();
+
+protected:
+    void complete();
+
+    // Rethrows the exception the state was completed with, if any
+    void rethrow() const;
+
+protected:
+    ThreadPool & m_pool;
+    std::exception_ptr m_exception;
+
+    std::atomic<bool> m_ready;
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_completed;
+    std::vector<std::function<void()>> m_continuations;
+};
+
+template <typename T>
+class FutureState : public FutureStateBase
+{
+public:
+    using Reference = const T &;
+
+    explicit FutureState(ThreadPool & pool);
+
+    void setValue(T value);
+    const T & value() const;
+
+protected:
+    std::unique_ptr<T> m_value;
+};
+
+template <>
+class FutureState<void> : public FutureStateBase
+{
+public:
+    using Reference = void;
+
+    explicit FutureState(ThreadPool & pool);
+
+    void setValue();
+    void value() const;
+};
+
+// Result of callback(const T &), or of callback() for T = void
+template <typename T, typename Callback>
+struct ContinuationResult
+{
+    using type = typename std::result_of<typename std::decay<Callback>::type &(const T &)>::type;
+};
+
+template <typename Callback>
+struct ContinuationResult<void, Callback>
+{
+    using type = typename std::result_of<typename std::decay<Callback>::type &()>::type;
+};
+
+// Value type of whenAll: the values of all futures, or nothing for T = void
+template <typename T>
+struct WhenAllResult
+{
+    using type = std::vector<T>;
+};
+
+template <>
+struct WhenAllResult<void>
+{
+    using type = void;
+};
+
+struct FutureAccess;
+
+// Abandons the state when the last Promise referring to it is destroyed
+class THREADINGZEUG_API PromiseOwner
+{
+public:
+    explicit PromiseOwner(std::shared_ptr<FutureStateBase> state);
+    ~PromiseOwner();
+
+    PromiseOwner(const PromiseOwner &) = delete;
+    PromiseOwner & operator=(const PromiseOwner &) = delete;
+
+protected:
+    std::shared_ptr<FutureStateBase> m_state;
+};
+
+
+} // namespace detail
+
+
+/** \brief Result of an asynchronous computation on a ThreadPool.
+
+    A Future is a cheap handle to a shared state; copies refer to the same result.
+    Continuations attached with then() are executed on the pool as soon as the
+    result is available, without blocking a thread in the meantime.
+    Waiting (wait() and get()) helps executing pending tasks of the pool, so it is
+    safe to wait from within a worker thread.
+
+    If the computation throws, the future becomes ready with the exception,
+    which get() rethrows and which is passed on to continuations and whenAll
+    without calling their callbacks.
+
+    \code{.cpp}
+
+        auto mesh = runAsync([] () { return loadMesh("bunny.obj"); });
+        auto bounds = mesh.then([] (const Mesh & mesh) { return computeBounds(mesh); });
+        auto loops = whenAll(std::vector<Future<void>>{ parallelForAsync(0, n, a), parallelForAsync(0, m, b) });
+
+        loops.wait();
+        std::cout << bounds.get() << std::endl;
+
+    \endcode
+
+    \see Promise
+    \see runAsync
+*/
+template <typename T>
+class Future
+{
+    friend struct detail::FutureAccess;
+
+public:
+    using ValueType = T;
+
+public:
+    /** Creates an invalid future without shared state.
+    */
+    Future();
+    explicit Future(std::shared_ptr<detail::FutureState<T>> state);
+
+    bool valid() const;
+    bool isReady() const;
+
+    void wait() const;
+
+    /** Waits for the result and returns a reference to it (nothing for Future<void>).
+        The reference is valid as long as any future referring to the same result exists.
+        Rethrows the exception if the computation failed.
+    */
+    typename detail::FutureState<T>::Reference get() const;
+
+    /** Returns a future for callback(result), or callback() for Future<void>,
+        which is executed on the pool once this future is ready.
+    */
+    template <typename Callback>
+    Future<typename detail::ContinuationResult<T, Callback>::type> then(Callback && callback) const;
+
+protected:
+    std::shared_ptr<detail::FutureState<T>> m_state;
+};
+
+
+/** \brief Producer side of a Future; the result is set explicitly with setValue() or setException().
+
+    Copies refer to the same result. If the last copy is destroyed without
+    setting it, the future fails with std::future_error (broken_promise).
+*/
+template <typename T>
+class Promise
+{
+public:
+    Promise();
+    explicit Promise(ThreadPool & pool);
+
+    Future<T> future() const;
+
+    /** Sets the result (without arguments for Promise<void>); must be called exactly once.
+    */
+    template <typename... Args>
+    void setValue(Args &&... args);
+
+    /** Fails the future with the given exception; instead of setValue().
+    */
+    void setException(std::exception_ptr exception);
+
+protected:
+    std::shared_ptr<detail::FutureState<T>> m_state;
+    std::shared_ptr<detail::PromiseOwner> m_owner;
+};
+
+
+/** Executes callback() as a task on the pool and returns a future for its result.
+*/
+template <typename Callback>
+Future<typename std::result_of<typename std::decay<Callback>::type &()>::type> runAsync(ThreadPool & pool, Callback && callback);
+
+template <typename Callback>
+Future<typename std::result_of<typename std::decay<Callback>::type &()>::type> runAsync(Callback && callback);
+
+/** Returns a future that is ready once all futures are ready.
+    For non-void T, its value contains the values of all futures in the given order.
+    If any of the futures failed, it fails with the exception of the first of them.
+*/
+template <typename T>
+Future<typename detail::WhenAllResult<T>::type> whenAll(const std::vector<Future<T>> & futures);
+
+/** Returns a future for the index of the first of the (non-empty) futures that becomes ready,
+    including futures that failed with an exception.
+*/
+template <typename T>
+Future<size_t> whenAny(const std::vector<Future<T>> & futures);
+
+
+} // namespace threadingzeug
+
+
+#include <threadingzeug/Future.hpp>
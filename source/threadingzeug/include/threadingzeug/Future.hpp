@@ -0,0 +1,334 @@
+
+#pragma once
+
+
+#include <threadingzeug/Future.h>
+
+#include <cassert>
+#include <utility>
+
+#include <threadingzeug/ThreadPool.h>
+
+
+namespace threadingzeug
+{
+
+
+namespace detail
+{
+
+
+template <typename T>
+FutureState<T>::FutureState(ThreadPool & pool)
+: FutureStateBase(pool)
+{
+}
+
+template <typename T>
+void FutureState<T>::setValue(T value)
+{
+    m_value.reset(new T(std::move(value)));
+    complete();
+}
+
+template <typename T>
+const T & FutureState<T>::value() const
+{
+    assert(isReady());
+
+    rethrow();
+
+    return *m_value;
+}
+
+inline FutureState<void>::FutureState(ThreadPool & pool)
+: FutureStateBase(pool)
+{
+}
+
+inline void FutureState<void>::setValue()
+{
+    complete();
+}
+
+inline void FutureState<void>::value() const
+{
+    assert(isReady());
+
+    rethrow();
+}
+
+// Sets the result of function() on state, or the exception it throws; distinguishes void results
+template <typename Result>
+struct FutureSetter
+{
+    template <typename Function>
+    static void set(FutureState<Result> & state, Function && function)
+    {
+        try
+        {
+            state.setValue(function());
+        }
+        catch (...)
+        {
+            state.setException(std::current_exception());
+        }
+    }
+};
+
+template <>
+struct FutureSetter<void>
+{
+    template <typename Function>
+    static void set(FutureState<void> & state, Function && function)
+    {
+        try
+        {
+            function();
+        }
+        catch (...)
+        {
+            state.setException(std::current_exception());
+            return;
+        }
+
+        state.setValue();
+    }
+};
+
+// Calls callback with the value of state, or without arguments for void
+template <typename T>
+struct FutureInvoker
+{
+    template <typename Callback>
+    static typename ContinuationResult<T, Callback>::type invoke(const FutureState<T> & state, Callback & callback)
+    {
+        return callback(state.value());
+    }
+};
+
+template <>
+struct FutureInvoker<void>
+{
+    template <typename Callback>
+    static typename ContinuationResult<void, Callback>::type invoke(const FutureState<void> & state, Callback & callback)
+    {
+        // Passes on the exception of the previous future
+        state.value();
+
+        return callback();
+    }
+};
+
+// Collects the values for whenAll; get() rethrows the exception of the first failed future
+template <typename T>
+struct WhenAllCollector
+{
+    static std::vector<T> collect(const std::vector<Future<T>> & futures)
+    {
+        auto values = std::vector<T>();
+        values.reserve(futures.size());
+
+        for (const auto & future : futures)
+        {
+            values.push_back(future.get());
+        }
+
+        return values;
+    }
+};
+
+template <>
+struct WhenAllCollector<void>
+{
+    static void collect(const std::vector<Future<void>> & futures)
+    {
+        for (const auto & future : futures)
+        {
+            future.get();
+        }
+    }
+};
+
+// Grants the free functions below access to the shared state of a future
+struct FutureAccess
+{
+    template <typename T>
+    static const std::shared_ptr<FutureState<T>> & state(const Future<T> & future)
+    {
+        return future.m_state;
+    }
+};
+
+
+} // namespace detail
+
+
+template <typename T>
+Future<T>::Future()
+{
+}
+
+template <typename T>
+Future<T>::Future(std::shared_ptr<detail::FutureState<T>> state)
+: m_state(std::move(state))
+{
+}
+
+template <typename T>
+bool Future<T>::valid() const
+{
+    return m_state != nullptr;
+}
+
+template <typename T>
+bool Future<T>::isReady() const
+{
+    assert(valid());
+
+    return m_state->isReady();
+}
+
+template <typename T>
+void Future<T>::wait() const
+{
+    assert(valid());
+
+    m_state->wait();
+}
+
+template <typename T>
+typename detail::FutureState<T>::Reference Future<T>::get() const
+{
+    wait();
+
+    return m_state->value();
+}
+
+template <typename T>
+template <typename Callback>
+Future<typename detail::ContinuationResult<T, Callback>::type> Future<T>::then(Callback && callback) const
+{
+    using Result = typename detail::ContinuationResult<T, Callback>::type;
+
+    assert(valid());
+
+    auto state = m_state;
+    auto next = std::make_shared<detail::FutureState<Result>>(m_state->pool());
+    auto function = typename std::decay<Callback>::type(std::forward<Callback>(callback));
+
+    m_state->then([state, next, function] () mutable {
+        detail::FutureSetter<Result>::set(*next, [&state, &function] () {
+            return detail::FutureInvoker<T>::invoke(*state, function);
+        });
+    });
+
+    return Future<Result>(next);
+}
+
+template <typename T>
+Promise<T>::Promise()
+: Promise(ThreadPool::instance())
+{
+}
+
+template <typename T>
+Promise<T>::Promise(ThreadPool & pool)
+: m_state(std::make_shared<detail::FutureState<T>>(pool))
+, m_owner(std::make_shared<detail::PromiseOwner>(m_state))
+{
+}
+
+template <typename T>
+Future<T> Promise<T>::future() const
+{
+    return Future<T>(m_state);
+}
+
+template <typename T>
+template <typename... Args>
+void Promise<T>::setValue(Args &&... args)
+{
+    m_state->setValue(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void Promise<T>::setException(std::exception_ptr exception)
+{
+    m_state->setException(std::move(exception));
+}
+
+template <typename Callback>
+Future<typename std::result_of<typename std::decay<Callback>::type &()>::type> runAsync(ThreadPool & pool, Callback && callback)
+{
+    using Result = typename std::result_of<typename std::decay<Callback>::type &()>::type;
+
+    auto state = std::make_shared<detail::FutureState<Result>>(pool);
+    auto function = typename std::decay<Callback>::type(std::forward<Callback>(callback));
+
+    pool.submit([state, function] () mutable {
+        detail::FutureSetter<Result>::set(*state, function);
+    });
+
+    return Future<Result>(state);
+}
+
+template <typename Callback>
+Future<typename std::result_of<typename std::decay<Callback>::type &()>::type> runAsync(Callback && callback)
+{
+    return runAsync(ThreadPool::instance(), std::forward<Callback>(callback));
+}
+
+template <typename T>
+Future<typename detail::WhenAllResult<T>::type> whenAll(const std::vector<Future<T>> & futures)
+{
+    using Result = typename detail::WhenAllResult<T>::type;
+
+    auto & pool = futures.empty() ? ThreadPool::instance() : detail::FutureAccess::state(futures.front())->pool();
+    auto state = std::make_shared<detail::FutureState<Result>>(pool);
+
+    if (futures.empty())
+    {
+        detail::FutureSetter<Result>::set(*state, [&futures] () { return detail::WhenAllCollector<T>::collect(futures); });
+        return Future<Result>(state);
+    }
+
+    auto inputs = std::make_shared<const std::vector<Future<T>>>(futures);
+    auto remaining = std::make_shared<std::atomic<size_t>>(futures.size());
+
+    for (const auto & future : futures)
+    {
+        assert(future.valid());
+
+        detail::FutureAccess::state(future)->then([state, inputs, remaining] () {
+            if (--*remaining == 0)
+                detail::FutureSetter<Result>::set(*state, [&inputs] () { return detail::WhenAllCollector<T>::collect(*inputs); });
+        });
+    }
+
+    return Future<Result>(state);
+}
+
+template <typename T>
+Future<size_t> whenAny(const std::vector<Future<T>> & futures)
+{
+    assert(!futures.empty());
+
+    auto state = std::make_shared<detail::FutureState<size_t>>(detail::FutureAccess::state(futures.front())->pool());
+    auto decided = std::make_shared<std::atomic<bool>>(false);
+
+    for (auto i = static_cast<size_t>(0); i < futures.size(); ++i)
+    {
+        assert(futures[i].valid());
+
+        detail::FutureAccess::state(futures[i])->then([state, decided, i] () {
+            if (!decided->exchange(true))
+                state->setValue(i);
+        });
+    }
+
+    return Future<size_t>(state);
+}
+
+
+} // namespace threadingzeug
@@ -0,0 +1,109 @@
+#pragma once
+
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <threadingzeug/threadingzeug_api.h>
+
+
+namespace threadingzeug
+{
+
+
+class ThreadPool;
+class TaskGroup;
+
+
+/** \brief Directed acyclic graph of tasks that is executed on a ThreadPool.
+
+    Each task declares its predecessors and is started as soon as all of them
+    have completed. The start and end time of every task is recorded per run and
+    can be used to determine the critical path of the graph.
+
+    \code{.cpp}
+
+        TaskGraph graph;
+        auto load   = graph.addTask("load",   [] () { ... });
+        auto decode = graph.addTask("decode", [] () { ... }, { load });
+        auto build  = graph.addTask("build",  [] () { ... }, { decode });
+        graph.addTask("serialize", [] () { ... }, { build });
+        graph.run();
+
+    \endcode
+
+    \see ThreadPool
+*/
+class THREADINGZEUG_API TaskGraph
+{
+public:
+    using TaskId = size_t;
+    using Clock = std::chrono::steady_clock;
+
+    // Start and end of a task relative to the start of the run
+    struct Timing
+    {
+        Clock::duration start;
+        Clock::duration end;
+    };
+
+public:
+    TaskGraph();
+    explicit TaskGraph(ThreadPool & pool);
+
+    TaskId addTask(const std::string & name, std::function<void()> task);
+    TaskId addTask(const std::string & name, std::function<void()> task, const std::vector<TaskId> & predecessors);
+
+    void addDependency(TaskId task, TaskId predecessor);
+
+    size_t size() const;
+    const std::string & name(TaskId task) const;
+    const std::vector<TaskId> & predecessors(TaskId task) const;
+
+    /** Executes all tasks and blocks until they have finished.
+        Returns false without executing anything if the graph contains a cycle.
+    */
+    bool run();
+
+    bool hasCycle() const;
+
+    const Timing & timing(TaskId task) const;
+    Clock::duration duration(TaskId task) const;
+
+    /** Wall clock time of the last run.
+    */
+    Clock::duration totalDuration() const;
+
+    /** Chain of tasks with the largest accumulated duration in the last run, from first to last task.
+    */
+    std::vector<TaskId> criticalPath() const;
+    Clock::duration criticalPathDuration() const;
+
+protected:
+    struct Node
+    {
+        std::string name;
+        std::function<void()> task;
+        std::vector<TaskId> predecessors;
+        std::vector<TaskId> successors;
+        Timing timing;
+    };
+
+    std::vector<TaskId> topologicalOrder() const;
+
+    void execute(TaskId task, std::vector<std::atomic<size_t>> & remaining, TaskGroup & group);
+
+protected:
+    ThreadPool & m_pool;
+    std::vector<Node> m_nodes;
+
+    Clock::time_point m_start;
+    Clock::duration m_totalDuration;
+};
+
+
+} // namespace threadingzeug
@@ -0,0 +1,66 @@
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+#include <threadingzeug/threadingzeug_api.h>
+
+
+namespace threadingzeug
+{
+
+
+class ThreadPool;
+
+
+/** \brief Runs a set of tasks on a ThreadPool and waits for their completion.
+
+    While waiting, the calling thread helps executing pending tasks of the pool,
+    so waiting from within a worker thread neither deadlocks nor idles the worker.
+
+    \code{.cpp}
+
+        TaskGroup group;
+        group.run([] () { ... });
+        group.run([] () { ... });
+        group.wait();
+
+    \endcode
+
+    \see ThreadPool
+*/
+class THREADINGZEUG_API TaskGroup
+{
+public:
+    TaskGroup();
+    explicit TaskGroup(ThreadPool & pool);
+
+    /** Waits for all tasks that were not yet waited for.
+    */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup & operator=(const TaskGroup &) = delete;
+
+    ThreadPool & pool() const;
+
+    void run(std::function<void()> task);
+    void wait();
+
+protected:
+    void finish();
+
+protected:
+    ThreadPool & m_pool;
+
+    std::atomic<size_t> m_pending;
+    std::mutex m_mutex;
+    std::condition_variable m_finished;
+};
+
+
+} // namespace threadingzeug
@@ -0,0 +1,126 @@
+#pragma once
+
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <threadingzeug/threadingzeug_api.h>
+
+
+namespace threadingzeug
+{
+
+
+/** \brief Persistent pool of worker threads with per-worker task deques and work stealing.
+
+    Each worker owns a deque of tasks. Tasks submitted from a worker are pushed
+    to the back of its own deque and popped from there again (LIFO, cache-friendly),
+    while idle workers steal from the front of the other deques. Tasks submitted
+    from threads outside the pool are placed in a shared injection queue.
+
+    The process-wide pool used by parallelFor and forEach is available via instance().
+
+    \see TaskGroup
+    \see parallelFor
+*/
+class THREADINGZEUG_API ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /** \brief Placement of the worker threads on the CPUs of the current Topology.
+        Pinning is supported on Linux only and ignored elsewhere.
+    */
+    enum class Pinning
+    {
+        None, ///< Workers may run on all CPUs of the topology
+        Node, ///< Workers are distributed evenly among the NUMA nodes and may run on all CPUs of their node
+        Cpu   ///< Each worker is bound to a single CPU, assigned round-robin node by node
+    };
+
+    static ThreadPool & instance();
+
+    /** Pool the calling thread is a worker of, nullptr for threads outside of any pool.
+    */
+    static ThreadPool * current();
+
+public:
+    explicit ThreadPool(size_t numberOfWorkers, Pinning pinning = Pinning::None);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    size_t numberOfWorkers() const;
+
+    bool isWorkerThread() const;
+
+    /** Finishes all pending tasks and restarts the pool with the given number of workers.
+        Must not be called while other threads submit tasks to this pool.
+    */
+    void setNumberOfWorkers(size_t numberOfWorkers);
+
+    Pinning pinning() const;
+
+    /** Re-pins the running workers according to the current Topology.
+    */
+    void setPinning(Pinning pinning);
+
+    /** CPUs the given worker was pinned to; empty if the worker is not pinned.
+    */
+    std::vector<size_t> workerCpus(size_t worker) const;
+
+    void submit(Task task);
+
+    /** Pops or steals a single pending task and executes it on the calling thread.
+        Returns false if no task was available.
+    */
+    bool runPendingTask();
+
+    /** Finishes all pending tasks and joins the worker threads.
+        Called by the destructor; submitting tasks afterwards is not allowed.
+    */
+    void shutdown();
+
+protected:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void start(size_t numberOfWorkers);
+    void work(size_t index);
+    void pin();
+
+    bool pop(size_t index, Task & task);
+    bool popInjected(Task & task);
+    bool steal(size_t thief, Task & task);
+
+    int currentWorkerIndex() const;
+
+protected:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    Pinning m_pinning;
+    std::vector<std::vector<size_t>> m_workerCpus;
+
+    std::mutex m_injectedMutex;
+    std::deque<Task> m_injected;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<size_t> m_pendingTasks;
+    bool m_shutdown;
+};
+
+
+} // namespace threadingzeug
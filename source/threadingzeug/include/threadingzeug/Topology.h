@@ -0,0 +1,90 @@
+#pragma once
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <threadingzeug/threadingzeug_api.h>
+
+
+namespace threadingzeug
+{
+
+
+/** \brief CPUs and NUMA nodes available to the process and its CPU quota.
+
+    On Linux, discover() takes the CPUs from the affinity mask (sched_getaffinity),
+    groups them by the NUMA nodes listed in /sys/devices/system/node and reads the
+    CPU quota of the process' cgroup (cpu.max for cgroup v2, cpu.cfs_quota_us and
+    cpu.cfs_period_us for cgroup v1). On other systems, all hardware threads are
+    assumed to belong to a single node without quota.
+
+    The topology used by threadingzeug (see current()) is discovered once and can be
+    overridden, e.g., to restrict the library to the CPUs of one node:
+
+    \code{.cpp}
+
+        auto topology = Topology::current();
+        topology.setNodes({ topology.nodes().front() });
+        topology.setCpus(topology.nodes().front().cpus);
+        Topology::setCurrent(topology);
+
+    \endcode
+
+    \see getNumberOfThreads
+    \see ThreadPool::setPinning
+*/
+class THREADINGZEUG_API Topology
+{
+public:
+    struct Node
+    {
+        size_t index;
+        std::vector<size_t> cpus; ///< Usable CPUs of this node
+    };
+
+public:
+    static Topology discover();
+
+    /** Topology used for the default number of threads and for pinning of workers.
+    */
+    static Topology current();
+
+    /** Replaces the current topology; resets the number of threads to the one derived from it.
+    */
+    static void setCurrent(const Topology & topology);
+
+    /** Parses a Linux CPU list such as "0-3,8,10-11".
+    */
+    static std::vector<size_t> parseCpuList(const std::string & list);
+
+public:
+    /** Creates a topology with a single node containing all hardware threads and no quota.
+    */
+    Topology();
+    Topology(const std::vector<size_t> & cpus, const std::vector<Node> & nodes, double cpuQuota = 0.0);
+
+    const std::vector<size_t> & cpus() const;
+    void setCpus(const std::vector<size_t> & cpus);
+
+    const std::vector<Node> & nodes() const;
+    void setNodes(const std::vector<Node> & nodes);
+
+    /** Number of CPUs the process may use according to its cgroup (may be fractional), 0 if unlimited.
+    */
+    double cpuQuota() const;
+    void setCpuQuota(double cpuQuota);
+
+    /** Number of CPUs, limited by the quota (rounded up), at least 1.
+    */
+    size_t numberOfThreads() const;
+
+protected:
+    std::vector<size_t> m_cpus;
+    std::vector<Node> m_nodes;
+    double m_cpuQuota;
+};
+
+
+} // namespace threadingzeug
@@ -3,18 +3,45 @@
 
 
 #include <functional>
+#include <type_traits>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
 #include <threadingzeug/threadingzeug_api.h>
+#include <threadingzeug/Future.h>
 
 
 namespace threadingzeug
 {
 
 
+/** Number of threads used by parallelFor and the global ThreadPool.
+    Unless overridden, derived from the current Topology, i.e., the CPUs in the
+    affinity mask of the process limited by its cgroup CPU quota.
+*/
 THREADINGZEUG_API size_t getNumberOfThreads();
 
+/** Overrides the number of threads; 0 restores the value derived from the current Topology.
+    Takes effect for subsequent parallel loops; the global ThreadPool keeps the number
+    of workers it was created with (see ThreadPool::setNumberOfWorkers).
+*/
+THREADINGZEUG_API void setNumberOfThreads(size_t numberOfThreads);
+
+
+/** \brief Policy for distributing the iterations of a parallelFor among the threads.
+
+    The policies behave the same for the OpenMP and the std::thread build.
+    Except for Static, iterations are handed out in chunks of grainSize iterations.
+*/
+enum class Schedule
+{
+    Static,        ///< One contiguous block of (almost) equal size per thread
+    StaticChunked, ///< Chunks assigned round-robin to the threads in advance
+    Dynamic,       ///< Chunks claimed by idle threads from a shared atomic counter
+    Guided         ///< Like Dynamic, but chunk size is proportional to the remaining iterations (at least grainSize)
+};
+
 
 // Necessary for type deduction with lambdas
 // see http://stackoverflow.com/questions/13358672/how-to-convert-a-lambda-to-an-stdfunction-using-templates
@@ -24,17 +51,95 @@ struct identity
     typedef T type;
 };
 
+namespace detail
+{
+
+template <typename Callback>
+struct isStdFunction : std::false_type
+{
+};
+
+template <typename Signature>
+struct isStdFunction<std::function<Signature>> : std::true_type
+{
+};
+
+// Selects the template callable overloads for everything but std::function,
+// which is taken by the std::function overloads below
+template <typename Callback>
+using EnableIfNotStdFunction = typename std::enable_if<!isStdFunction<typename std::decay<Callback>::type>::value>::type;
+
+} // namespace detail
+
+
+// Overloads taking the callable as template parameter; the loop body is inlined into the loop
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void forEach(T start, T end, Callback && callback, bool parallelize = true);
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void parallelFor(T start, T end, Callback && callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void parallelFor(const std::vector<T> & elements, Callback && callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void parallelFor(std::vector<T> & elements, Callback && callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
+
+/** Hands contiguous sub-ranges [begin, end) of at most grainSize iterations to callback(begin, end),
+    so that a task processes a whole block (e.g., with SIMD) instead of a single index per call.
+    With Schedule::Static, grainSize is ignored and each thread processes exactly one block.
+*/
+template<typename T, typename Callback>
+void parallelForRange(T start, T end, size_t grainSize, Callback && callback, Schedule schedule = Schedule::StaticChunked);
+
+/** Non-blocking variants of parallelFor: the iterations are distributed to tasks on the
+    ThreadPool (for the OpenMP build as well) and the returned future is ready once all
+    iterations have been executed. The callback is copied; elements and everything captured
+    by reference have to outlive the future. If the callback throws, the remaining iterations
+    of the throwing task are skipped and the future fails with the first exception.
+
+    \code{.cpp}
+
+        auto first = parallelForAsync<size_t>(0, a.size(), [&a] (size_t i) { a[i] = f(i); });
+        auto second = parallelForAsync<size_t>(0, b.size(), [&b] (size_t i) { b[i] = g(i); });
+
+        whenAll(std::vector<Future<void>>{ first, second }).then([] () { ... });
+
+    \endcode
+*/
+template<typename T, typename Callback>
+Future<void> parallelForAsync(T start, T end, Callback && callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
+
+template<typename T, typename Callback>
+Future<void> parallelForAsync(const std::vector<T> & elements, Callback && callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
+
+template<typename T, typename Callback>
+Future<void> parallelForAsync(std::vector<T> & elements, Callback && callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void sequentialFor(T start, T end, Callback && callback);
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void sequentialFor(const std::vector<T> & elements, Callback && callback);
+
+template<typename T, typename Callback, typename = detail::EnableIfNotStdFunction<Callback>>
+void sequentialFor(std::vector<T> & elements, Callback && callback);
+
+
+// std::function overloads; forward to the overloads above
+
 template<typename T>
 void forEach(T start, T end, typename identity<std::function<void(T)>>::type callback, bool parallelize = true);
 
 template<typename T>
-void parallelFor(T start, T end, typename identity<std::function<void(T)>>::type callback);
+void parallelFor(T start, T end, typename identity<std::function<void(T)>>::type callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
 
 template<typename T>
-void parallelFor(const std::vector<T> & elements, typename identity<std::function<void(const T & element)>>::type callback);
+void parallelFor(const std::vector<T> & elements, typename identity<std::function<void(const T & element)>>::type callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
 
 template<typename T>
-void parallelFor(std::vector<T> & elements, typename identity<std::function<void(T & element)>>::type callback);
+void parallelFor(std::vector<T> & elements, typename identity<std::function<void(T & element)>>::type callback, Schedule schedule = Schedule::Static, size_t grainSize = 1);
 
 template<typename T>
 void sequentialFor(T start, T end, typename identity<std::function<void(T)>>::type callback);
@@ -46,7 +151,6 @@ template<typename T>
 void sequentialFor(std::vector<T> & elements, typename identity<std::function<void(T & element)>>::type callback);
 
 
-
 } // namespace threadingzeug
 
 
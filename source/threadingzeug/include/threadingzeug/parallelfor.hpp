@@ -4,87 +4,294 @@
 
 #include <threadingzeug/parallelfor.h>
 
-#include <cmath>
-#include <future>
+#include <atomic>
+#include <exception>
+#include <memory>
 #include <vector>
 #include <algorithm>
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+#include <threadingzeug/ThreadPool.h>
+#include <threadingzeug/TaskGroup.h>
+
 
 namespace threadingzeug
 {
 
 
-#ifndef USE_OPENMP
-    const auto numberOfThreads = getNumberOfThreads();
-#endif
+namespace detail
+{
 
 
-template<typename T>
-void forEach(T start, T end, typename identity<std::function<void(T)>>::type callback, bool parallelize)
+// Pool of the calling worker thread, so that nested loops are distributed to the same
+// workers instead of adding threads; the global pool for threads outside of any pool
+inline ThreadPool & currentPool()
 {
-    (parallelize ?
-        static_cast<void(*)(T, T, std::function<void(T)>)>(parallelFor) :
-        static_cast<void(*)(T, T, std::function<void(T)>)>(sequentialFor)
-    )(start, end, callback);
+    const auto pool = ThreadPool::current();
+
+    return pool ? *pool : ThreadPool::instance();
 }
 
-template<typename T>
-void parallelFor(T start, T end, typename identity<std::function<void(T)>>::type callback)
+// Number of threads a parallelFor is distributed to
+inline size_t numberOfParallelThreads()
 {
 #ifdef USE_OPENMP
+    return std::min(static_cast<size_t>(omp_get_max_threads()), getNumberOfThreads());
+#else
+    return currentPool().numberOfWorkers();
+#endif
+}
 
-    using signed_T = typename std::make_signed<T>::type;
-
-    #pragma omp parallel for
-    for (signed_T i = static_cast<signed_T>(start); i < static_cast<signed_T>(end); ++i)
+// Executes the share of thread 'thread' out of 'numberOfThreads' of the iterations [0, count)
+// and hands each claimed chunk [begin, end) to range
+template<typename Range>
+void scheduleChunks(size_t thread, size_t numberOfThreads, size_t count, Schedule schedule, size_t grainSize, std::atomic<size_t> & next, const Range & range)
+{
+    switch (schedule)
     {
-        callback(static_cast<T>(i));
-    }
+    case Schedule::StaticChunked:
+        for (auto begin = thread * grainSize; begin < count; begin += numberOfThreads * grainSize)
+        {
+            range(begin, std::min(begin + grainSize, count));
+        }
+        break;
 
-#else
+    case Schedule::Dynamic:
+        for (auto begin = next.fetch_add(grainSize); begin < count; begin = next.fetch_add(grainSize))
+        {
+            range(begin, std::min(begin + grainSize, count));
+        }
+        break;
 
-    auto futures = std::vector<std::future<void>>(numberOfThreads);
-    auto count = end - start;
-    auto step = static_cast<size_t>(std::ceil(float(count) / numberOfThreads));
+    case Schedule::Guided:
+        {
+            auto begin = next.load();
 
-    for (auto i = static_cast<size_t>(0); i < numberOfThreads; ++i)
-    {
-        futures[i] = std::async(std::launch::async, [i, step, start, end, &callback] () {
-            const auto e = std::min(static_cast<T>(start + (i+1) * step), end);
+            while (begin < count)
+            {
+                const auto chunk = std::max(grainSize, (count - begin) / (2 * numberOfThreads));
+                const auto end = std::min(begin + chunk, count);
+
+                // On failure, begin is updated to the current counter value
+                if (next.compare_exchange_weak(begin, end))
+                {
+                    range(begin, end);
+                    begin = next.load();
+                }
+            }
+        }
+        break;
+
+    case Schedule::Static:
+    default:
+        {
+            // Integer split; the first (count % numberOfThreads) threads take one more iteration
+            const auto step = count / numberOfThreads;
+            const auto remainder = count % numberOfThreads;
+            const auto begin = thread * step + std::min(thread, remainder);
+            const auto end = begin + step + (thread < remainder ? 1 : 0);
 
-            for (auto k = start + i * step; k < e; ++k)
+            if (begin < end)
             {
-                callback(k);
+                range(begin, end);
             }
-        });
+        }
+        break;
     }
+}
 
-    for (auto & future : futures)
+// Distributes [start, end) according to schedule and hands each chunk [begin, end) to range
+template<typename T, typename Range>
+void parallelChunks(T start, T end, Schedule schedule, size_t grainSize, const Range & range)
+{
+    if (!(start < end))
+        return;
+
+    const auto count = static_cast<size_t>(end - start);
+    grainSize = std::max(static_cast<size_t>(1), grainSize);
+
+    std::atomic<size_t> next(0);
+
+    const auto chunk = [start, &range] (size_t chunkBegin, size_t chunkEnd) {
+        range(static_cast<T>(start + static_cast<T>(chunkBegin)), static_cast<T>(start + static_cast<T>(chunkEnd)));
+    };
+
+#ifdef USE_OPENMP
+
+    // Nested in a parallel region, all threads of the team are busy already
+    if (omp_in_parallel())
     {
-        future.wait();
+        scheduleChunks(0, 1, count, schedule, grainSize, next, chunk);
+        return;
+    }
+
+    // On a pool worker (e.g., within parallelForAsync), an OpenMP team per worker would
+    // multiply the number of threads; the loop is distributed to the pool below instead
+    if (!ThreadPool::current())
+    {
+        #pragma omp parallel num_threads(static_cast<int>(numberOfParallelThreads()))
+        {
+            scheduleChunks(static_cast<size_t>(omp_get_thread_num()), static_cast<size_t>(omp_get_num_threads()),
+                count, schedule, grainSize, next, chunk);
+        }
+
+        return;
     }
 
 #endif
+
+    // Nested loops push their tasks to the deque of the calling worker and help executing them
+    // while waiting, so the number of threads stays bounded by the number of workers
+    auto & pool = currentPool();
+    const auto numberOfTasks = pool.numberOfWorkers();
+
+    TaskGroup group(pool);
+
+    for (auto i = static_cast<size_t>(0); i < numberOfTasks; ++i)
+    {
+        group.run([i, numberOfTasks, count, schedule, grainSize, &next, &chunk] () {
+            scheduleChunks(i, numberOfTasks, count, schedule, grainSize, next, chunk);
+        });
+    }
+
+    group.wait();
 }
 
-template<typename T>
-void parallelFor(const std::vector<T> & elements, typename identity<std::function<void(const T & element)>>::type callback)
+
+} // namespace detail
+
+
+template<typename T, typename Callback, typename>
+void forEach(T start, T end, Callback && callback, bool parallelize)
 {
-    parallelFor(0, elements.size(), [callback, &elements](size_t i) {
+    if (parallelize)
+    {
+        parallelFor(start, end, callback);
+    }
+    else
+    {
+        sequentialFor(start, end, callback);
+    }
+}
+
+template<typename T, typename Callback, typename>
+void parallelFor(T start, T end, Callback && callback, Schedule schedule, size_t grainSize)
+{
+    detail::parallelChunks(start, end, schedule, grainSize, [&callback] (T chunkBegin, T chunkEnd) {
+        for (auto k = chunkBegin; k < chunkEnd; ++k)
+        {
+            callback(k);
+        }
+    });
+}
+
+template<typename T, typename Callback, typename>
+void parallelFor(const std::vector<T> & elements, Callback && callback, Schedule schedule, size_t grainSize)
+{
+    parallelFor<size_t>(0, elements.size(), [&callback, &elements](size_t i) {
 		callback(elements[i]);
-	});
+	}, schedule, grainSize);
 }
 
-template<typename T>
-void parallelFor(std::vector<T> & elements, typename identity<std::function<void(T & element)>>::type callback)
+template<typename T, typename Callback, typename>
+void parallelFor(std::vector<T> & elements, Callback && callback, Schedule schedule, size_t grainSize)
 {
-    parallelFor(0, elements.size(), [callback, &elements](size_t i) {
+    parallelFor<size_t>(0, elements.size(), [&callback, &elements](size_t i) {
 		callback(elements[i]);
-	});
+	}, schedule, grainSize);
 }
 
-template<typename T>
-void sequentialFor(T start, T end, typename identity<std::function<void(T)>>::type callback)
+template<typename T, typename Callback>
+void parallelForRange(T start, T end, size_t grainSize, Callback && callback, Schedule schedule)
+{
+    detail::parallelChunks(start, end, schedule, grainSize, [&callback] (T chunkBegin, T chunkEnd) {
+        callback(chunkBegin, chunkEnd);
+    });
+}
+
+template<typename T, typename Callback>
+Future<void> parallelForAsync(T start, T end, Callback && callback, Schedule schedule, size_t grainSize)
+{
+    auto & pool = detail::currentPool();
+
+    Promise<void> promise(pool);
+
+    if (!(start < end))
+    {
+        promise.setValue();
+        return promise.future();
+    }
+
+    const auto count = static_cast<size_t>(end - start);
+    const auto numberOfTasks = pool.numberOfWorkers();
+    grainSize = std::max(static_cast<size_t>(1), grainSize);
+
+    // Shared by all tasks; the last task to finish fulfills the promise
+    auto function = std::make_shared<typename std::decay<Callback>::type>(std::forward<Callback>(callback));
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+    auto remaining = std::make_shared<std::atomic<size_t>>(numberOfTasks);
+    auto failed = std::make_shared<std::atomic<bool>>(false);
+    auto exception = std::make_shared<std::exception_ptr>();
+
+    for (auto i = static_cast<size_t>(0); i < numberOfTasks; ++i)
+    {
+        pool.submit([i, numberOfTasks, start, count, schedule, grainSize, function, next, remaining, failed, exception, promise] () mutable {
+            try
+            {
+                detail::scheduleChunks(i, numberOfTasks, count, schedule, grainSize, *next, [start, &function] (size_t chunkBegin, size_t chunkEnd) {
+                    const auto chunkEndT = static_cast<T>(start + static_cast<T>(chunkEnd));
+
+                    for (auto k = static_cast<T>(start + static_cast<T>(chunkBegin)); k < chunkEndT; ++k)
+                    {
+                        (*function)(k);
+                    }
+                });
+            }
+            catch (...)
+            {
+                // The first exception fails the future once all tasks are finished
+                if (!failed->exchange(true))
+                    *exception = std::current_exception();
+            }
+
+            if (--*remaining != 0)
+                return;
+
+            if (*failed)
+                promise.setException(*exception);
+            else
+                promise.setValue();
+        });
+    }
+
+    return promise.future();
+}
+
+template<typename T, typename Callback>
+Future<void> parallelForAsync(const std::vector<T> & elements, Callback && callback, Schedule schedule, size_t grainSize)
+{
+    auto function = typename std::decay<Callback>::type(std::forward<Callback>(callback));
+
+    return parallelForAsync<size_t>(0, elements.size(), [&elements, function] (size_t i) mutable {
+        function(elements[i]);
+    }, schedule, grainSize);
+}
+
+template<typename T, typename Callback>
+Future<void> parallelForAsync(std::vector<T> & elements, Callback && callback, Schedule schedule, size_t grainSize)
+{
+    auto function = typename std::decay<Callback>::type(std::forward<Callback>(callback));
+
+    return parallelForAsync<size_t>(0, elements.size(), [&elements, function] (size_t i) mutable {
+        function(elements[i]);
+    }, schedule, grainSize);
+}
+
+template<typename T, typename Callback, typename>
+void sequentialFor(T start, T end, Callback && callback)
 {
     for (auto i = start; i < end; ++i)
     {
@@ -92,21 +299,62 @@ void sequentialFor(T start, T end, typename identity<std::function<void(T)>>::ty
     }
 }
 
-template<typename T>
-void sequentialFor(const std::vector<T> & elements, typename identity<std::function<void(const T & element)>>::type callback)
+template<typename T, typename Callback, typename>
+void sequentialFor(const std::vector<T> & elements, Callback && callback)
 {
-    sequentialFor(0, elements.size(), [callback, &elements](size_t i) {
+    sequentialFor<size_t>(0, elements.size(), [&callback, &elements](size_t i) {
 		callback(elements[i]);
 	});
 }
 
-template<typename T>
-void sequentialFor(std::vector<T>& elements, typename identity<std::function<void(T& element)>>::type callback)
+template<typename T, typename Callback, typename>
+void sequentialFor(std::vector<T> & elements, Callback && callback)
 {
-    sequentialFor(0, elements.size(), [callback, &elements](size_t i) {
+    sequentialFor<size_t>(0, elements.size(), [&callback, &elements](size_t i) {
 		callback(elements[i]);
 	});
 }
 
+template<typename T>
+void forEach(T start, T end, typename identity<std::function<void(T)>>::type callback, bool parallelize)
+{
+    forEach(start, end, std::cref(callback), parallelize);
+}
+
+template<typename T>
+void parallelFor(T start, T end, typename identity<std::function<void(T)>>::type callback, Schedule schedule, size_t grainSize)
+{
+    parallelFor(start, end, std::cref(callback), schedule, grainSize);
+}
+
+template<typename T>
+void parallelFor(const std::vector<T> & elements, typename identity<std::function<void(const T & element)>>::type callback, Schedule schedule, size_t grainSize)
+{
+    parallelFor(elements, std::cref(callback), schedule, grainSize);
+}
+
+template<typename T>
+void parallelFor(std::vector<T> & elements, typename identity<std::function<void(T & element)>>::type callback, Schedule schedule, size_t grainSize)
+{
+    parallelFor(elements, std::cref(callback), schedule, grainSize);
+}
+
+template<typename T>
+void sequentialFor(T start, T end, typename identity<std::function<void(T)>>::type callback)
+{
+    sequentialFor(start, end, std::cref(callback));
+}
+
+template<typename T>
+void sequentialFor(const std::vector<T> & elements, typename identity<std::function<void(const T & element)>>::type callback)
+{
+    sequentialFor(elements, std::cref(callback));
+}
+
+template<typename T>
+void sequentialFor(std::vector<T> & elements, typename identity<std::function<void(T & element)>>::type callback)
+{
+    sequentialFor(elements, std::cref(callback));
+}
 
 } // namespace threadingzeug
@@ -0,0 +1,65 @@
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+#include <threadingzeug/threadingzeug_api.h>
+#include <threadingzeug/parallelfor.h>
+
+
+namespace threadingzeug
+{
+
+
+/** Reduces [start, end) by splitting it into blocks, folding each block with
+    rangeReduce(begin, end, partial) -> Value starting from identity and combining the
+    per-block partials with reduce(Value, Value) -> Value.
+
+    The blocks depend only on the number of iterations, not on the number of threads,
+    and partials are combined in block order. Thus, the result is reproducible even for
+    non-associative operations such as floating point addition.
+
+    \code{.cpp}
+
+        // Histogram of 8 bit values
+        auto histogram = parallelReduce<size_t>(0, data.size(), std::vector<size_t>(256, 0),
+            [&data] (size_t begin, size_t end, std::vector<size_t> partial) {
+                for (auto i = begin; i < end; ++i)
+                    ++partial[data[i]];
+                return partial;
+            },
+            [] (std::vector<size_t> a, const std::vector<size_t> & b) {
+                for (auto i = 0; i < 256; ++i)
+                    a[i] += b[i];
+                return a;
+            });
+
+    \endcode
+*/
+template<typename T, typename Value, typename RangeReduce, typename Reduce>
+Value parallelReduce(T start, T end, Value identity, RangeReduce && rangeReduce, Reduce && reduce);
+
+/** Reduces all elements with reduce(Value, Value) -> Value, identity being the neutral element.
+    \see parallelReduce(T, T, Value, RangeReduce &&, Reduce &&)
+*/
+template<typename Value, typename Reduce>
+Value parallelReduce(const std::vector<Value> & elements, Value identity, Reduce && reduce);
+
+/** Reduces transform(i) for all i in [start, end) with reduce(Value, Value) -> Value.
+    \see parallelReduce(T, T, Value, RangeReduce &&, Reduce &&)
+*/
+template<typename T, typename Value, typename Transform, typename Reduce>
+Value parallelTransformReduce(T start, T end, Value identity, Transform && transform, Reduce && reduce);
+
+/** Reduces transform(element) for all elements with reduce(Value, Value) -> Value.
+    \see parallelReduce(T, T, Value, RangeReduce &&, Reduce &&)
+*/
+template<typename T, typename Value, typename Transform, typename Reduce>
+Value parallelTransformReduce(const std::vector<T> & elements, Value identity, Transform && transform, Reduce && reduce);
+
+
+} // namespace threadingzeug
+
+
+#include <threadingzeug/parallelreduce.hpp>
@@ -0,0 +1,116 @@
+
+#pragma once
+
+
+#include <threadingzeug/parallelreduce.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+namespace threadingzeug
+{
+
+
+namespace detail
+{
+
+
+const size_t cacheLineSize = 64;
+
+// Separates adjacent values by at least a cache line to avoid false sharing
+template <typename Value>
+struct CacheLinePadded
+{
+    Value value;
+    char padding[cacheLineSize];
+};
+
+// Block size used by reductions and scans; depends on the number of iterations only,
+// so that the combination order is the same for any number of threads
+inline size_t deterministicBlockSize(size_t count)
+{
+    const auto minimumBlockSize = static_cast<size_t>(1024);
+    const auto maximumNumberOfBlocks = static_cast<size_t>(256);
+
+    return std::max(minimumBlockSize, (count + maximumNumberOfBlocks - 1) / maximumNumberOfBlocks);
+}
+
+
+} // namespace detail
+
+
+template<typename T, typename Value, typename RangeReduce, typename Reduce>
+Value parallelReduce(T start, T end, Value identity, RangeReduce && rangeReduce, Reduce && reduce)
+{
+    if (!(start < end))
+        return identity;
+
+    const auto count = static_cast<size_t>(end - start);
+    const auto blockSize = detail::deterministicBlockSize(count);
+    const auto numberOfBlocks = (count + blockSize - 1) / blockSize;
+
+    if (numberOfBlocks == 1)
+        return reduce(identity, rangeReduce(start, end, identity));
+
+    auto partials = std::vector<detail::CacheLinePadded<Value>>(numberOfBlocks, detail::CacheLinePadded<Value>{ identity, {} });
+
+    parallelFor<size_t>(0, numberOfBlocks, [start, count, blockSize, &identity, &partials, &rangeReduce] (size_t block) {
+        const auto blockBegin = static_cast<T>(start + static_cast<T>(block * blockSize));
+        const auto blockEnd = static_cast<T>(start + static_cast<T>(std::min((block + 1) * blockSize, count)));
+
+        partials[block].value = rangeReduce(blockBegin, blockEnd, identity);
+    }, Schedule::Dynamic);
+
+    auto result = std::move(identity);
+
+    for (auto & partial : partials)
+    {
+        result = reduce(std::move(result), std::move(partial.value));
+    }
+
+    return result;
+}
+
+template<typename Value, typename Reduce>
+Value parallelReduce(const std::vector<Value> & elements, Value identity, Reduce && reduce)
+{
+    return parallelReduce<size_t>(0, elements.size(), std::move(identity), [&elements, &reduce] (size_t begin, size_t end, Value partial) {
+        for (auto i = begin; i < end; ++i)
+        {
+            partial = reduce(std::move(partial), elements[i]);
+        }
+
+        return partial;
+    }, reduce);
+}
+
+template<typename T, typename Value, typename Transform, typename Reduce>
+Value parallelTransformReduce(T start, T end, Value identity, Transform && transform, Reduce && reduce)
+{
+    return parallelReduce(start, end, std::move(identity), [&transform, &reduce] (T chunkBegin, T chunkEnd, Value partial) {
+        for (auto i = chunkBegin; i < chunkEnd; ++i)
+        {
+            partial = reduce(std::move(partial), transform(i));
+        }
+
+        return partial;
+    }, reduce);
+}
+
+template<typename T, typename Value, typename Transform, typename Reduce>
+Value parallelTransformReduce(const std::vector<T> & elements, Value identity, Transform && transform, Reduce && reduce)
+{
+    return parallelReduce<size_t>(0, elements.size(), std::move(identity), [&elements, &transform, &reduce] (size_t begin, size_t end, Value partial) {
+        for (auto i = begin; i < end; ++i)
+        {
+            partial = reduce(std::move(partial), transform(elements[i]));
+        }
+
+        return partial;
+    }, reduce);
+}
+
+
+} // namespace threadingzeug
@@ -0,0 +1,36 @@
+#pragma once
+
+
+#include <threadingzeug/threadingzeug_api.h>
+#include <threadingzeug/parallelreduce.h>
+
+
+namespace threadingzeug
+{
+
+
+/** Writes the inclusive prefix combination of [first, last) with operation to output
+    (output[i] = first[0] op ... op first[i]) and returns the end of the output range.
+
+    Iterators have to be random access; output may equal first for an in-place scan.
+    Like parallelReduce, the blocks depend only on the number of elements, so that
+    results are reproducible for any number of threads.
+
+    \see parallelReduce
+*/
+template<typename InputIterator, typename OutputIterator, typename Operation>
+OutputIterator parallelInclusiveScan(InputIterator first, InputIterator last, OutputIterator output, Operation && operation);
+
+/** Writes the exclusive prefix combination of [first, last) with operation to output
+    (output[0] = init, output[i] = init op first[0] op ... op first[i - 1]) and returns the end of the output range.
+
+    \see parallelInclusiveScan
+*/
+template<typename InputIterator, typename OutputIterator, typename Value, typename Operation>
+OutputIterator parallelExclusiveScan(InputIterator first, InputIterator last, OutputIterator output, Value init, Operation && operation);
+
+
+} // namespace threadingzeug
+
+
+#include <threadingzeug/parallelscan.hpp>
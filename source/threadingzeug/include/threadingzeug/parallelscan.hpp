@@ -0,0 +1,144 @@
+
+#pragma once
+
+
+#include <threadingzeug/parallelscan.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+namespace threadingzeug
+{
+
+
+template<typename InputIterator, typename OutputIterator, typename Operation>
+OutputIterator parallelInclusiveScan(InputIterator first, InputIterator last, OutputIterator output, Operation && operation)
+{
+    using Value = typename std::iterator_traits<InputIterator>::value_type;
+
+    const auto count = static_cast<size_t>(std::distance(first, last));
+
+    if (count == 0)
+        return output;
+
+    const auto blockSize = detail::deterministicBlockSize(count);
+    const auto numberOfBlocks = (count + blockSize - 1) / blockSize;
+
+    // Scans the block starting with 'offset' combined with its first element (if any)
+    const auto scanBlock = [first, output, count, blockSize, &operation] (size_t block, const Value * offset) {
+        const auto begin = block * blockSize;
+        const auto end = std::min(begin + blockSize, count);
+
+        auto value = offset ? operation(*offset, first[begin]) : Value(first[begin]);
+        output[begin] = value;
+
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            value = operation(std::move(value), first[i]);
+            output[i] = value;
+        }
+    };
+
+    if (numberOfBlocks == 1)
+    {
+        scanBlock(0, nullptr);
+        return output + count;
+    }
+
+    // 1. Combine all elements of each block but the last
+    auto sums = std::vector<detail::CacheLinePadded<Value>>(numberOfBlocks - 1);
+
+    parallelFor<size_t>(0, numberOfBlocks - 1, [first, blockSize, &sums, &operation] (size_t block) {
+        const auto begin = block * blockSize;
+
+        auto value = Value(first[begin]);
+
+        for (auto i = begin + 1; i < begin + blockSize; ++i)
+        {
+            value = operation(std::move(value), first[i]);
+        }
+
+        sums[block].value = std::move(value);
+    }, Schedule::Dynamic);
+
+    // 2. Sequentially turn the block sums into the offsets of the following blocks
+    for (auto block = static_cast<size_t>(1); block < sums.size(); ++block)
+    {
+        sums[block].value = operation(sums[block - 1].value, sums[block].value);
+    }
+
+    // 3. Scan each block starting with its offset
+    parallelFor<size_t>(0, numberOfBlocks, [&sums, &scanBlock] (size_t block) {
+        scanBlock(block, block > 0 ? &sums[block - 1].value : nullptr);
+    }, Schedule::Dynamic);
+
+    return output + count;
+}
+
+template<typename InputIterator, typename OutputIterator, typename Value, typename Operation>
+OutputIterator parallelExclusiveScan(InputIterator first, InputIterator last, OutputIterator output, Value init, Operation && operation)
+{
+    const auto count = static_cast<size_t>(std::distance(first, last));
+
+    if (count == 0)
+        return output;
+
+    const auto blockSize = detail::deterministicBlockSize(count);
+    const auto numberOfBlocks = (count + blockSize - 1) / blockSize;
+
+    // Scans the block starting with 'offset'; reads each element before overwriting it to allow in-place scans
+    const auto scanBlock = [first, output, count, blockSize, &operation] (size_t block, Value offset) {
+        const auto begin = block * blockSize;
+        const auto end = std::min(begin + blockSize, count);
+
+        for (auto i = begin; i < end; ++i)
+        {
+            auto next = operation(offset, first[i]);
+            output[i] = std::move(offset);
+            offset = std::move(next);
+        }
+    };
+
+    if (numberOfBlocks == 1)
+    {
+        scanBlock(0, std::move(init));
+        return output + count;
+    }
+
+    // 1. Combine all elements of each block but the last
+    auto offsets = std::vector<detail::CacheLinePadded<Value>>(numberOfBlocks);
+
+    parallelFor<size_t>(0, numberOfBlocks - 1, [first, blockSize, &offsets, &operation] (size_t block) {
+        const auto begin = block * blockSize;
+
+        auto value = Value(first[begin]);
+
+        for (auto i = begin + 1; i < begin + blockSize; ++i)
+        {
+            value = operation(std::move(value), first[i]);
+        }
+
+        offsets[block + 1].value = std::move(value);
+    }, Schedule::Dynamic);
+
+    // 2. Sequentially turn the block sums into the offsets of the blocks
+    offsets[0].value = std::move(init);
+
+    for (auto block = static_cast<size_t>(1); block < offsets.size(); ++block)
+    {
+        offsets[block].value = operation(offsets[block - 1].value, offsets[block].value);
+    }
+
+    // 3. Scan each block starting with its offset
+    parallelFor<size_t>(0, numberOfBlocks, [&offsets, &scanBlock] (size_t block) {
+        scanBlock(block, offsets[block].value);
+    }, Schedule::Dynamic);
+
+    return output + count;
+}
+
+
+} // namespace threadingzeug
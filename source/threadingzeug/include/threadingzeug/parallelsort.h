@@ -0,0 +1,47 @@
+#pragma once
+
+
+#include <threadingzeug/threadingzeug_api.h>
+#include <threadingzeug/parallelfor.h>
+
+
+namespace threadingzeug
+{
+
+
+// Below this number of elements, the sequential std algorithms are used
+const size_t parallelSortThreshold = 16384;
+
+
+/** Sorts [first, last) with operator< using a parallel merge sort.
+    Ranges with less than parallelSortThreshold elements are sorted with std::sort.
+*/
+template<typename RandomAccessIterator>
+void parallelSort(RandomAccessIterator first, RandomAccessIterator last);
+
+/** Sorts [first, last) with compare using a parallel merge sort.
+    With parallelize set to false (or for less than parallelSortThreshold elements), std::sort is used.
+*/
+template<typename RandomAccessIterator, typename Compare>
+void parallelSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare, bool parallelize = true);
+
+/** Like parallelSort, but preserves the order of equivalent elements (falls back to std::stable_sort).
+*/
+template<typename RandomAccessIterator>
+void parallelStableSort(RandomAccessIterator first, RandomAccessIterator last);
+
+template<typename RandomAccessIterator, typename Compare>
+void parallelStableSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare, bool parallelize = true);
+
+/** Moves all elements satisfying predicate before all others, preserving the relative order
+    within both groups, and returns the first element of the second group.
+    With parallelize set to false (or for less than parallelSortThreshold elements), std::stable_partition is used.
+*/
+template<typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator parallelPartition(RandomAccessIterator first, RandomAccessIterator last, Predicate predicate, bool parallelize = true);
+
+
+} // namespace threadingzeug
+
+
+#include <threadingzeug/parallelsort.hpp>
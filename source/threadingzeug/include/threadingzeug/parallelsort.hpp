@@ -0,0 +1,253 @@
+
+#pragma once
+
+
+#include <threadingzeug/parallelsort.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <threadingzeug/parallelreduce.h>
+
+
+namespace threadingzeug
+{
+
+
+namespace detail
+{
+
+
+// Merge of [aBegin, aEnd) and [bBegin, bEnd) of the source into the destination at 'output' (all offsets)
+struct MergePiece
+{
+    size_t aBegin;
+    size_t aEnd;
+    size_t bBegin;
+    size_t bEnd;
+    size_t output;
+};
+
+// Splits the merge into independent pieces by bisecting the larger input at its middle element;
+// the split points keep equivalent elements of the first input before those of the second
+template<typename Iterator, typename Compare>
+void splitMerge(Iterator source, const MergePiece & piece, size_t numberOfPieces, Compare & compare, std::vector<MergePiece> & pieces)
+{
+    const auto aSize = piece.aEnd - piece.aBegin;
+    const auto bSize = piece.bEnd - piece.bBegin;
+
+    if (numberOfPieces <= 1 || aSize + bSize < parallelSortThreshold)
+    {
+        pieces.push_back(piece);
+        return;
+    }
+
+    auto aSplit = piece.aBegin;
+    auto bSplit = piece.bBegin;
+
+    if (aSize >= bSize)
+    {
+        aSplit = piece.aBegin + aSize / 2;
+        bSplit = static_cast<size_t>(std::lower_bound(source + piece.bBegin, source + piece.bEnd, source[aSplit], compare) - source);
+    }
+    else
+    {
+        bSplit = piece.bBegin + bSize / 2;
+        aSplit = static_cast<size_t>(std::upper_bound(source + piece.aBegin, source + piece.aEnd, source[bSplit], compare) - source);
+    }
+
+    const auto left = MergePiece{ piece.aBegin, aSplit, piece.bBegin, bSplit, piece.output };
+    const auto right = MergePiece{ aSplit, piece.aEnd, bSplit, piece.bEnd, piece.output + (aSplit - piece.aBegin) + (bSplit - piece.bBegin) };
+
+    splitMerge(source, left, numberOfPieces / 2, compare, pieces);
+    splitMerge(source, right, numberOfPieces - numberOfPieces / 2, compare, pieces);
+}
+
+// Merges all pairs of adjacent sorted runs of the given width from source into destination
+template<typename SourceIterator, typename DestinationIterator, typename Compare>
+void mergeRuns(SourceIterator source, DestinationIterator destination, size_t count, size_t width, size_t numberOfThreads, Compare & compare)
+{
+    const auto numberOfPairs = (count + 2 * width - 1) / (2 * width);
+    const auto piecesPerPair = std::max(static_cast<size_t>(1), 4 * numberOfThreads / numberOfPairs);
+
+    auto pieces = std::vector<MergePiece>();
+
+    for (auto begin = static_cast<size_t>(0); begin < count; begin += 2 * width)
+    {
+        const auto middle = std::min(begin + width, count);
+        const auto end = std::min(begin + 2 * width, count);
+
+        splitMerge(source, MergePiece{ begin, middle, middle, end, begin }, piecesPerPair, compare, pieces);
+    }
+
+    parallelFor(pieces, [source, destination, &compare] (const MergePiece & piece) {
+        std::merge(std::make_move_iterator(source + piece.aBegin), std::make_move_iterator(source + piece.aEnd),
+            std::make_move_iterator(source + piece.bBegin), std::make_move_iterator(source + piece.bEnd),
+            destination + piece.output, compare);
+    }, Schedule::Dynamic);
+}
+
+// Sorts blocks with blockSort and merges them pairwise in parallel, alternating between the range and a buffer
+template<typename RandomAccessIterator, typename Compare, typename BlockSort>
+void parallelMergeSort(RandomAccessIterator first, RandomAccessIterator last, Compare & compare, const BlockSort & blockSort)
+{
+    using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+    const auto count = static_cast<size_t>(last - first);
+    const auto numberOfThreads = numberOfParallelThreads();
+
+    // Power of two number of blocks, at least one per thread, but each of at least parallelSortThreshold / 2 elements
+    auto numberOfBlocks = static_cast<size_t>(1);
+    while (numberOfBlocks < numberOfThreads && count / (numberOfBlocks * 2) >= parallelSortThreshold / 2)
+    {
+        numberOfBlocks *= 2;
+    }
+
+    if (numberOfBlocks == 1)
+    {
+        blockSort(first, last, compare);
+        return;
+    }
+
+    const auto blockSize = (count + numberOfBlocks - 1) / numberOfBlocks;
+
+    parallelFor<size_t>(0, numberOfBlocks, [first, count, blockSize, &compare, &blockSort] (size_t block) {
+        blockSort(first + std::min(block * blockSize, count), first + std::min((block + 1) * blockSize, count), compare);
+    }, Schedule::Dynamic);
+
+    auto buffer = std::vector<Value>(std::make_move_iterator(first), std::make_move_iterator(last));
+    auto resultInBuffer = true;
+
+    for (auto width = blockSize; width < count; width *= 2)
+    {
+        if (resultInBuffer)
+        {
+            mergeRuns(buffer.begin(), first, count, width, numberOfThreads, compare);
+        }
+        else
+        {
+            mergeRuns(first, buffer.begin(), count, width, numberOfThreads, compare);
+        }
+
+        resultInBuffer = !resultInBuffer;
+    }
+
+    if (resultInBuffer)
+    {
+        parallelForRange<size_t>(0, count, parallelSortThreshold, [first, &buffer] (size_t begin, size_t end) {
+            std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+        });
+    }
+}
+
+
+} // namespace detail
+
+
+template<typename RandomAccessIterator>
+void parallelSort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    parallelSort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template<typename RandomAccessIterator, typename Compare>
+void parallelSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare, bool parallelize)
+{
+    if (!parallelize || static_cast<size_t>(last - first) < parallelSortThreshold)
+    {
+        std::sort(first, last, compare);
+        return;
+    }
+
+    detail::parallelMergeSort(first, last, compare, [] (RandomAccessIterator begin, RandomAccessIterator end, Compare & blockCompare) {
+        std::sort(begin, end, blockCompare);
+    });
+}
+
+template<typename RandomAccessIterator>
+void parallelStableSort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    parallelStableSort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
+template<typename RandomAccessIterator, typename Compare>
+void parallelStableSort(RandomAccessIterator first, RandomAccessIterator last, Compare compare, bool parallelize)
+{
+    if (!parallelize || static_cast<size_t>(last - first) < parallelSortThreshold)
+    {
+        std::stable_sort(first, last, compare);
+        return;
+    }
+
+    detail::parallelMergeSort(first, last, compare, [] (RandomAccessIterator begin, RandomAccessIterator end, Compare & blockCompare) {
+        std::stable_sort(begin, end, blockCompare);
+    });
+}
+
+template<typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator parallelPartition(RandomAccessIterator first, RandomAccessIterator last, Predicate predicate, bool parallelize)
+{
+    using Value = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+    const auto count = static_cast<size_t>(last - first);
+
+    if (!parallelize || count < parallelSortThreshold)
+    {
+        return std::stable_partition(first, last, predicate);
+    }
+
+    const auto blockSize = detail::deterministicBlockSize(count);
+    const auto numberOfBlocks = (count + blockSize - 1) / blockSize;
+
+    // 1. Evaluate the predicate once per element and count the matches per block
+    auto flags = std::vector<char>(count);
+    auto offsets = std::vector<detail::CacheLinePadded<size_t>>(numberOfBlocks + 1);
+
+    parallelFor<size_t>(0, numberOfBlocks, [first, count, blockSize, &flags, &offsets, &predicate] (size_t block) {
+        const auto end = std::min((block + 1) * blockSize, count);
+        auto matches = static_cast<size_t>(0);
+
+        for (auto i = block * blockSize; i < end; ++i)
+        {
+            flags[i] = predicate(first[i]) ? 1 : 0;
+            matches += flags[i];
+        }
+
+        offsets[block + 1].value = matches;
+    }, Schedule::Dynamic);
+
+    // 2. Offsets of the matching elements of each block
+    offsets[0].value = 0;
+
+    for (auto block = static_cast<size_t>(1); block <= numberOfBlocks; ++block)
+    {
+        offsets[block].value += offsets[block - 1].value;
+    }
+
+    const auto numberOfMatches = offsets[numberOfBlocks].value;
+
+    // 3. Scatter back from a buffer; non-matching elements of a block start after all matches
+    //    plus the non-matching elements of the preceding blocks
+    auto buffer = std::vector<Value>(std::make_move_iterator(first), std::make_move_iterator(last));
+
+    parallelFor<size_t>(0, numberOfBlocks, [first, count, blockSize, numberOfMatches, &flags, &offsets, &buffer] (size_t block) {
+        const auto begin = block * blockSize;
+        const auto end = std::min(begin + blockSize, count);
+
+        auto match = offsets[block].value;
+        auto mismatch = numberOfMatches + begin - offsets[block].value;
+
+        for (auto i = begin; i < end; ++i)
+        {
+            first[flags[i] ? match++ : mismatch++] = std::move(buffer[i]);
+        }
+    }, Schedule::Dynamic);
+
+    return first + numberOfMatches;
+}
+
+
+} // namespace threadingzeug
@@ -0,0 +1,121 @@
+
+#include <threadingzeug/Future.h>
+
+#include <cassert>
+#include <chrono>
+#include <future>
+
+#include <threadingzeug/ThreadPool.h>
+
+
+namespace threadingzeug
+{
+
+
+namespace detail
+{
+
+
+FutureStateBase::FutureStateBase(ThreadPool & pool)
+: m_pool(pool)
+, m_ready(false)
+{
+}
+
+ThreadPool & FutureStateBase::pool() const
+{
+    return m_pool;
+}
+
+bool FutureStateBase::isReady() const
+{
+    return m_ready;
+}
+
+void FutureStateBase::wait() const
+{
+    while (!m_ready)
+    {
+        if (m_pool.runPendingTask())
+            continue;
+
+        // The result is computed by another thread; re-check the pool periodically
+        // since the computation may spawn further work
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_completed.wait_for(lock, std::chrono::microseconds(100), [this] () { return m_ready.load(); });
+    }
+}
+
+void FutureStateBase::then(std::function<void()> continuation)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_ready)
+        {
+            m_continuations.push_back(std::move(continuation));
+            return;
+        }
+    }
+
+    m_pool.submit(std::move(continuation));
+}
+
+void FutureStateBase::setException(std::exception_ptr exception)
+{
+    assert(exception != nullptr);
+
+    m_exception = std::move(exception);
+    complete();
+}
+
+void FutureStateBase::abandon()
+{
+    if (m_ready)
+        return;
+
+    setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+}
+
+void FutureStateBase::complete()
+{
+    auto continuations = std::vector<std::function<void()>>();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        assert(!m_ready);
+
+        m_ready = true;
+        continuations.swap(m_continuations);
+    }
+
+    m_completed.notify_all();
+
+    for (auto & continuation : continuations)
+    {
+        m_pool.submit(std::move(continuation));
+    }
+}
+
+void FutureStateBase::rethrow() const
+{
+    if (m_exception)
+        std::rethrow_exception(m_exception);
+}
+
+PromiseOwner::PromiseOwner(std::shared_ptr<FutureStateBase> state)
+: m_state(std::move(state))
+{
+}
+
+PromiseOwner::~PromiseOwner()
+{
+    m_state->abandon();
+}
+
+
+} // namespace detail
+
+
+} // namespace threadingzeug
@@ -0,0 +1,248 @@
+
+#include <threadingzeug/TaskGraph.h>
+
+#include <cassert>
+#include <algorithm>
+
+#include <threadingzeug/ThreadPool.h>
+#include <threadingzeug/TaskGroup.h>
+
+
+namespace threadingzeug
+{
+
+
+TaskGraph::TaskGraph()
+: TaskGraph(ThreadPool::instance())
+{
+}
+
+TaskGraph::TaskGraph(ThreadPool & pool)
+: m_pool(pool)
+, m_totalDuration(Clock::duration::zero())
+{
+}
+
+TaskGraph::TaskId TaskGraph::addTask(const std::string & name, std::function<void()> task)
+{
+    m_nodes.push_back(Node{ name, std::move(task), {}, {}, Timing{ Clock::duration::zero(), Clock::duration::zero() } });
+
+    return m_nodes.size() - 1;
+}
+
+TaskGraph::TaskId TaskGraph::addTask(const std::string & name, std::function<void()> task, const std::vector<TaskId> & predecessors)
+{
+    const auto id = addTask(name, std::move(task));
+
+    for (const auto predecessor : predecessors)
+    {
+        addDependency(id, predecessor);
+    }
+
+    return id;
+}
+
+void TaskGraph::addDependency(TaskId task, TaskId predecessor)
+{
+    assert(task < m_nodes.size());
+    assert(predecessor < m_nodes.size());
+
+    m_nodes[task].predecessors.push_back(predecessor);
+    m_nodes[predecessor].successors.push_back(task);
+}
+
+size_t TaskGraph::size() const
+{
+    return m_nodes.size();
+}
+
+const std::string & TaskGraph::name(TaskId task) const
+{
+    assert(task < m_nodes.size());
+
+    return m_nodes[task].name;
+}
+
+const std::vector<TaskGraph::TaskId> & TaskGraph::predecessors(TaskId task) const
+{
+    assert(task < m_nodes.size());
+
+    return m_nodes[task].predecessors;
+}
+
+bool TaskGraph::run()
+{
+    if (hasCycle())
+        return false;
+
+    auto remaining = std::vector<std::atomic<size_t>>(m_nodes.size());
+
+    for (auto i = static_cast<size_t>(0); i < m_nodes.size(); ++i)
+    {
+        remaining[i] = m_nodes[i].predecessors.size();
+    }
+
+    m_start = Clock::now();
+
+    {
+        TaskGroup group(m_pool);
+
+        for (auto i = static_cast<size_t>(0); i < m_nodes.size(); ++i)
+        {
+            if (m_nodes[i].predecessors.empty())
+            {
+                group.run([this, i, &remaining, &group] () {
+                    execute(i, remaining, group);
+                });
+            }
+        }
+
+        group.wait();
+    }
+
+    m_totalDuration = Clock::now() - m_start;
+
+    return true;
+}
+
+void TaskGraph::execute(TaskId task, std::vector<std::atomic<size_t>> & remaining, TaskGroup & group)
+{
+    while (true)
+    {
+        auto & node = m_nodes[task];
+
+        node.timing.start = Clock::now() - m_start;
+        node.task();
+        node.timing.end = Clock::now() - m_start;
+
+        // Continue with the first successor that became ready on this thread, hand the others to the pool
+        auto next = m_nodes.size();
+
+        for (const auto successor : node.successors)
+        {
+            if (--remaining[successor] != 0)
+                continue;
+
+            if (next == m_nodes.size())
+            {
+                next = successor;
+                continue;
+            }
+
+            group.run([this, successor, &remaining, &group] () {
+                execute(successor, remaining, group);
+            });
+        }
+
+        if (next == m_nodes.size())
+            break;
+
+        task = next;
+    }
+}
+
+bool TaskGraph::hasCycle() const
+{
+    return topologicalOrder().size() != m_nodes.size();
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::topologicalOrder() const
+{
+    auto order = std::vector<TaskId>();
+    order.reserve(m_nodes.size());
+
+    auto remaining = std::vector<size_t>(m_nodes.size());
+
+    for (auto i = static_cast<size_t>(0); i < m_nodes.size(); ++i)
+    {
+        remaining[i] = m_nodes[i].predecessors.size();
+
+        if (remaining[i] == 0)
+            order.push_back(i);
+    }
+
+    // Kahn's algorithm; tasks on a cycle never become ready
+    for (auto i = static_cast<size_t>(0); i < order.size(); ++i)
+    {
+        for (const auto successor : m_nodes[order[i]].successors)
+        {
+            if (--remaining[successor] == 0)
+                order.push_back(successor);
+        }
+    }
+
+    return order;
+}
+
+const TaskGraph::Timing & TaskGraph::timing(TaskId task) const
+{
+    assert(task < m_nodes.size());
+
+    return m_nodes[task].timing;
+}
+
+TaskGraph::Clock::duration TaskGraph::duration(TaskId task) const
+{
+    return timing(task).end - timing(task).start;
+}
+
+TaskGraph::Clock::duration TaskGraph::totalDuration() const
+{
+    return m_totalDuration;
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::criticalPath() const
+{
+    const auto order = topologicalOrder();
+
+    if (order.size() != m_nodes.size() || m_nodes.empty())
+        return std::vector<TaskId>();
+
+    // Longest path by duration, computed in topological order
+    auto accumulated = std::vector<Clock::duration>(m_nodes.size(), Clock::duration::zero());
+    auto previous = std::vector<TaskId>(m_nodes.size(), m_nodes.size());
+
+    for (const auto task : order)
+    {
+        auto longest = Clock::duration::zero();
+
+        for (const auto predecessor : m_nodes[task].predecessors)
+        {
+            if (previous[task] == m_nodes.size() || accumulated[predecessor] > longest)
+            {
+                longest = accumulated[predecessor];
+                previous[task] = predecessor;
+            }
+        }
+
+        accumulated[task] = longest + duration(task);
+    }
+
+    auto last = static_cast<TaskId>(std::max_element(accumulated.begin(), accumulated.end()) - accumulated.begin());
+
+    auto path = std::vector<TaskId>();
+
+    for (auto task = last; task != m_nodes.size(); task = previous[task])
+    {
+        path.push_back(task);
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+TaskGraph::Clock::duration TaskGraph::criticalPathDuration() const
+{
+    auto total = Clock::duration::zero();
+
+    for (const auto task : criticalPath())
+    {
+        total += duration(task);
+    }
+
+    return total;
+}
+
+
+} // namespace threadingzeug
@@ -0,0 +1,70 @@
+
+#include <threadingzeug/TaskGroup.h>
+
+#include <chrono>
+
+#include <threadingzeug/ThreadPool.h>
+
+
+namespace threadingzeug
+{
+
+
+TaskGroup::TaskGroup()
+: TaskGroup(ThreadPool::instance())
+{
+}
+
+TaskGroup::TaskGroup(ThreadPool & pool)
+: m_pool(pool)
+, m_pending(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+ThreadPool & TaskGroup::pool() const
+{
+    return m_pool;
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+    ++m_pending;
+
+    m_pool.submit([this, task] () {
+        task();
+        finish();
+    });
+}
+
+void TaskGroup::wait()
+{
+    while (m_pending > 0)
+    {
+        if (m_pool.runPendingTask())
+            continue;
+
+        // All remaining tasks of this group are being executed by other threads;
+        // re-check the pool periodically since they may spawn further work
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait_for(lock, std::chrono::microseconds(100), [this] () { return m_pending == 0; });
+    }
+
+    // Synchronize with the last finishing task, which may still hold the mutex
+    std::lock_guard<std::mutex> lock(m_mutex);
+}
+
+void TaskGroup::finish()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (--m_pending == 0)
+        m_finished.notify_all();
+}
+
+
+} // namespace threadingzeug
@@ -0,0 +1,314 @@
+
+#include <threadingzeug/ThreadPool.h>
+
+#include <cassert>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <threadingzeug/parallelfor.h>
+#include <threadingzeug/Topology.h>
+
+
+namespace
+{
+
+
+// Identifies the pool and worker the current thread belongs to (if any)
+thread_local threadingzeug::ThreadPool * t_pool = nullptr;
+thread_local int t_workerIndex = -1;
+
+
+} // namespace
+
+
+namespace threadingzeug
+{
+
+
+ThreadPool & ThreadPool::instance()
+{
+    static ThreadPool pool(getNumberOfThreads());
+
+    return pool;
+}
+
+ThreadPool * ThreadPool::current()
+{
+    return t_pool;
+}
+
+ThreadPool::ThreadPool(size_t numberOfWorkers, Pinning pinning)
+: m_pinning(pinning)
+, m_pendingTasks(0)
+, m_shutdown(false)
+{
+    start(numberOfWorkers);
+}
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+}
+
+size_t ThreadPool::numberOfWorkers() const
+{
+    return m_workers.size();
+}
+
+bool ThreadPool::isWorkerThread() const
+{
+    return t_pool == this;
+}
+
+void ThreadPool::setNumberOfWorkers(size_t numberOfWorkers)
+{
+    shutdown();
+    start(numberOfWorkers);
+}
+
+ThreadPool::Pinning ThreadPool::pinning() const
+{
+    return m_pinning;
+}
+
+void ThreadPool::setPinning(Pinning pinning)
+{
+    m_pinning = pinning;
+    pin();
+}
+
+std::vector<size_t> ThreadPool::workerCpus(size_t worker) const
+{
+    assert(worker < m_workers.size());
+
+    return worker < m_workerCpus.size() ? m_workerCpus[worker] : std::vector<size_t>();
+}
+
+void ThreadPool::start(size_t numberOfWorkers)
+{
+    assert(m_threads.empty());
+
+    numberOfWorkers = std::max(static_cast<size_t>(1), numberOfWorkers);
+
+    m_shutdown = false;
+
+    m_workers.clear();
+    for (auto i = static_cast<size_t>(0); i < numberOfWorkers; ++i)
+    {
+        m_workers.emplace_back(new Worker);
+    }
+
+    for (auto i = static_cast<size_t>(0); i < numberOfWorkers; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::work, this, i);
+    }
+
+    pin();
+}
+
+void ThreadPool::pin()
+{
+    const auto topology = Topology::current();
+    const auto & nodes = topology.nodes();
+
+    m_workerCpus.assign(m_threads.size(), std::vector<size_t>());
+
+    if (nodes.empty())
+        return;
+
+    // Workers per node are assigned in blocks, so that consecutive workers share a node
+    for (auto i = static_cast<size_t>(0); i < m_threads.size(); ++i)
+    {
+        const auto nodeIndex = i * nodes.size() / m_threads.size();
+        const auto & node = nodes[nodeIndex];
+
+        switch (m_pinning)
+        {
+        case Pinning::Node:
+            m_workerCpus[i] = node.cpus;
+            break;
+
+        case Pinning::Cpu:
+            if (!node.cpus.empty())
+            {
+                // Position of worker i among the workers of its node
+                const auto firstOfNode = (nodeIndex * m_threads.size() + nodes.size() - 1) / nodes.size();
+                m_workerCpus[i].push_back(node.cpus[(i - firstOfNode) % node.cpus.size()]);
+            }
+            break;
+
+        case Pinning::None:
+        default:
+            break;
+        }
+    }
+
+#ifdef __linux__
+    for (auto i = static_cast<size_t>(0); i < m_threads.size(); ++i)
+    {
+        // Unpinned workers may run on all CPUs of the topology
+        const auto & cpus = m_workerCpus[i].empty() ? topology.cpus() : m_workerCpus[i];
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (const auto cpu : cpus)
+        {
+            if (cpu < static_cast<size_t>(CPU_SETSIZE))
+                CPU_SET(cpu, &set);
+        }
+
+        pthread_setaffinity_np(m_threads[i].native_handle(), sizeof(set), &set);
+    }
+#endif
+}
+
+void ThreadPool::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_shutdown = true;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (auto & thread : m_threads)
+    {
+        thread.join();
+    }
+
+    m_threads.clear();
+}
+
+void ThreadPool::submit(Task task)
+{
+    {
+        // Counted before the task becomes visible so that the counter never underflows
+        // and under the sleep mutex so that no worker misses the wake up
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        ++m_pendingTasks;
+    }
+
+    const auto index = currentWorkerIndex();
+
+    if (index >= 0)
+    {
+        auto & worker = *m_workers[index];
+
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_injectedMutex);
+        m_injected.push_back(std::move(task));
+    }
+
+    m_wakeUp.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    const auto index = currentWorkerIndex();
+
+    Task task;
+
+    if (index >= 0)
+    {
+        if (!pop(index, task) && !popInjected(task) && !steal(index, task))
+            return false;
+    }
+    else
+    {
+        if (!popInjected(task) && !steal(0, task))
+            return false;
+    }
+
+    --m_pendingTasks;
+    task();
+
+    return true;
+}
+
+void ThreadPool::work(size_t index)
+{
+    t_pool = this;
+    t_workerIndex = static_cast<int>(index);
+
+    while (true)
+    {
+        if (runPendingTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.wait(lock, [this] () { return m_shutdown || m_pendingTasks > 0; });
+
+        if (m_shutdown && m_pendingTasks == 0)
+            break;
+    }
+
+    t_pool = nullptr;
+    t_workerIndex = -1;
+}
+
+bool ThreadPool::pop(size_t index, Task & task)
+{
+    auto & worker = *m_workers[index];
+
+    std::lock_guard<std::mutex> lock(worker.mutex);
+
+    if (worker.tasks.empty())
+        return false;
+
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+
+    return true;
+}
+
+bool ThreadPool::popInjected(Task & task)
+{
+    std::lock_guard<std::mutex> lock(m_injectedMutex);
+
+    if (m_injected.empty())
+        return false;
+
+    task = std::move(m_injected.front());
+    m_injected.pop_front();
+
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task & task)
+{
+    const auto numberOfWorkers = m_workers.size();
+
+    for (auto i = static_cast<size_t>(1); i <= numberOfWorkers; ++i)
+    {
+        auto & victim = *m_workers[(thief + i) % numberOfWorkers];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (victim.tasks.empty())
+            continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+
+        return true;
+    }
+
+    return false;
+}
+
+int ThreadPool::currentWorkerIndex() const
+{
+    return t_pool == this ? t_workerIndex : -1;
+}
+
+
+} // namespace threadingzeug
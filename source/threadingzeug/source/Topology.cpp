@@ -0,0 +1,348 @@
+
+#include <threadingzeug/Topology.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sched.h>
+#endif
+
+#include <threadingzeug/parallelfor.h>
+
+
+namespace
+{
+
+
+std::vector<size_t> allHardwareThreads()
+{
+    auto cpus = std::vector<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (auto i = static_cast<size_t>(0); i < cpus.size(); ++i)
+    {
+        cpus[i] = i;
+    }
+
+    return cpus;
+}
+
+#ifdef __linux__
+
+bool readLine(const std::string & path, std::string & line)
+{
+    std::ifstream stream(path);
+
+    return static_cast<bool>(std::getline(stream, line));
+}
+
+std::vector<size_t> affinityCpus()
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return allHardwareThreads();
+
+    auto cpus = std::vector<size_t>();
+
+    for (auto i = 0; i < CPU_SETSIZE; ++i)
+    {
+        if (CPU_ISSET(i, &set))
+            cpus.push_back(static_cast<size_t>(i));
+    }
+
+    return cpus.empty() ? allHardwareThreads() : cpus;
+}
+
+std::vector<threadingzeug::Topology::Node> numaNodes(const std::vector<size_t> & cpus)
+{
+    const auto directory = std::string("/sys/devices/system/node");
+
+    auto nodes = std::vector<threadingzeug::Topology::Node>();
+
+    DIR * dir = opendir(directory.c_str());
+    if (!dir)
+        return nodes;
+
+    while (dirent * entry = readdir(dir))
+    {
+        const auto name = std::string(entry->d_name);
+
+        if (name.compare(0, 4, "node") != 0 || name.size() == 4 || name.find_first_not_of("0123456789", 4) != std::string::npos)
+            continue;
+
+        auto list = std::string();
+        if (!readLine(directory + "/" + name + "/cpulist", list))
+            continue;
+
+        auto node = threadingzeug::Topology::Node{ static_cast<size_t>(std::strtoul(name.c_str() + 4, nullptr, 10)), {} };
+
+        // Only CPUs in the affinity mask are usable
+        for (const auto cpu : threadingzeug::Topology::parseCpuList(list))
+        {
+            if (std::binary_search(cpus.begin(), cpus.end(), cpu))
+                node.cpus.push_back(cpu);
+        }
+
+        if (!node.cpus.empty())
+            nodes.push_back(node);
+    }
+
+    closedir(dir);
+
+    std::sort(nodes.begin(), nodes.end(), [] (const threadingzeug::Topology::Node & a, const threadingzeug::Topology::Node & b) {
+        return a.index < b.index;
+    });
+
+    return nodes;
+}
+
+// Smaller of two quotas, 0 meaning unlimited
+double smallerQuota(double a, double b)
+{
+    if (a <= 0.0)
+        return std::max(0.0, b);
+
+    return b > 0.0 ? std::min(a, b) : a;
+}
+
+// Smallest quota from the cgroup directory of the process up to the root of the hierarchy
+template <typename ReadQuota>
+double hierarchyQuota(const std::string & mount, std::string path, const ReadQuota & readQuota)
+{
+    auto quota = 0.0;
+
+    while (true)
+    {
+        quota = smallerQuota(quota, readQuota(mount + path));
+
+        if (path.empty() || path == "/")
+            break;
+
+        const auto slash = path.find_last_of('/');
+        path = slash == std::string::npos ? std::string() : path.substr(0, slash);
+    }
+
+    return quota;
+}
+
+// cgroup v2: "<quota> <period>" or "max <period>"
+double cgroup2Quota(const std::string & directory)
+{
+    auto line = std::string();
+    if (!readLine(directory + "/cpu.max", line))
+        return 0.0;
+
+    std::istringstream stream(line);
+
+    auto quota = std::string();
+    auto period = 0.0;
+
+    if (!(stream >> quota >> period) || quota == "max" || period <= 0.0)
+        return 0.0;
+
+    return std::strtod(quota.c_str(), nullptr) / period;
+}
+
+// cgroup v1: quota of -1 means unlimited
+double cgroup1Quota(const std::string & directory)
+{
+    auto quota = std::string();
+    auto period = std::string();
+
+    if (!readLine(directory + "/cpu.cfs_quota_us", quota) || !readLine(directory + "/cpu.cfs_period_us", period))
+        return 0.0;
+
+    const auto q = std::strtod(quota.c_str(), nullptr);
+    const auto p = std::strtod(period.c_str(), nullptr);
+
+    return q > 0.0 && p > 0.0 ? q / p : 0.0;
+}
+
+double cgroupQuota()
+{
+    // Lines of /proc/self/cgroup are "<id>:<controllers>:<path>"; the controllers are empty for v2
+    std::ifstream cgroups("/proc/self/cgroup");
+
+    auto quota = 0.0;
+    auto line = std::string();
+
+    while (std::getline(cgroups, line))
+    {
+        const auto first = line.find(':');
+        const auto second = first == std::string::npos ? std::string::npos : line.find(':', first + 1);
+
+        if (second == std::string::npos)
+            continue;
+
+        const auto controllers = "," + line.substr(first + 1, second - first - 1) + ",";
+        const auto path = line.substr(second + 1);
+
+        // The v2 hierarchy is mounted at /sys/fs/cgroup/unified in hybrid setups
+        if (controllers == ",,")
+        {
+            quota = smallerQuota(quota, hierarchyQuota("/sys/fs/cgroup", path, cgroup2Quota));
+            quota = smallerQuota(quota, hierarchyQuota("/sys/fs/cgroup/unified", path, cgroup2Quota));
+        }
+        else if (controllers.find(",cpu,") != std::string::npos)
+        {
+            quota = smallerQuota(quota, hierarchyQuota("/sys/fs/cgroup/cpu", path, cgroup1Quota));
+            quota = smallerQuota(quota, hierarchyQuota("/sys/fs/cgroup/cpu,cpuacct", path, cgroup1Quota));
+        }
+    }
+
+    return quota;
+}
+
+#endif
+
+std::mutex & currentMutex()
+{
+    static std::mutex mutex;
+
+    return mutex;
+}
+
+std::unique_ptr<threadingzeug::Topology> & currentTopology()
+{
+    static std::unique_ptr<threadingzeug::Topology> topology;
+
+    return topology;
+}
+
+
+} // namespace
+
+
+namespace threadingzeug
+{
+
+
+Topology Topology::discover()
+{
+#ifdef __linux__
+    const auto cpus = affinityCpus();
+
+    auto nodes = numaNodes(cpus);
+
+    if (nodes.empty())
+        nodes.push_back(Node{ 0, cpus });
+
+    return Topology(cpus, nodes, cgroupQuota());
+#else
+    return Topology();
+#endif
+}
+
+Topology Topology::current()
+{
+    std::lock_guard<std::mutex> lock(currentMutex());
+
+    auto & topology = currentTopology();
+
+    if (!topology)
+        topology.reset(new Topology(discover()));
+
+    return *topology;
+}
+
+void Topology::setCurrent(const Topology & topology)
+{
+    {
+        std::lock_guard<std::mutex> lock(currentMutex());
+        currentTopology().reset(new Topology(topology));
+    }
+
+    setNumberOfThreads(0);
+}
+
+std::vector<size_t> Topology::parseCpuList(const std::string & list)
+{
+    auto cpus = std::vector<size_t>();
+
+    std::istringstream stream(list);
+    auto range = std::string();
+
+    while (std::getline(stream, range, ','))
+    {
+        if (range.find_first_of("0123456789") == std::string::npos)
+            continue;
+
+        const auto dash = range.find('-');
+
+        const auto first = std::strtoul(range.c_str(), nullptr, 10);
+        const auto last = dash == std::string::npos ? first : std::strtoul(range.c_str() + dash + 1, nullptr, 10);
+
+        for (auto cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(static_cast<size_t>(cpu));
+        }
+    }
+
+    return cpus;
+}
+
+Topology::Topology()
+: m_cpus(allHardwareThreads())
+, m_nodes(1, Node{ 0, m_cpus })
+, m_cpuQuota(0.0)
+{
+}
+
+Topology::Topology(const std::vector<size_t> & cpus, const std::vector<Node> & nodes, double cpuQuota)
+: m_cpus(cpus)
+, m_nodes(nodes)
+, m_cpuQuota(cpuQuota)
+{
+}
+
+const std::vector<size_t> & Topology::cpus() const
+{
+    return m_cpus;
+}
+
+void Topology::setCpus(const std::vector<size_t> & cpus)
+{
+    m_cpus = cpus;
+}
+
+const std::vector<Topology::Node> & Topology::nodes() const
+{
+    return m_nodes;
+}
+
+void Topology::setNodes(const std::vector<Node> & nodes)
+{
+    m_nodes = nodes;
+}
+
+double Topology::cpuQuota() const
+{
+    return m_cpuQuota;
+}
+
+void Topology::setCpuQuota(double cpuQuota)
+{
+    m_cpuQuota = cpuQuota;
+}
+
+size_t Topology::numberOfThreads() const
+{
+    auto numberOfThreads = std::max(static_cast<size_t>(1), m_cpus.size());
+
+    if (m_cpuQuota > 0.0)
+        numberOfThreads = std::min(numberOfThreads, static_cast<size_t>(std::ceil(m_cpuQuota)));
+
+    return std::max(static_cast<size_t>(1), numberOfThreads);
+}
+
+
+} // namespace threadingzeug
@@ -1,6 +1,21 @@
 
 #include <threadingzeug/parallelfor.h>
 
+#include <atomic>
+
+#include <threadingzeug/Topology.h>
+
+
+namespace
+{
+
+
+// Either overridden or derived from the topology on first use; 0 if not yet known
+std::atomic<size_t> s_numberOfThreads(0);
+
+
+} // namespace
+
 
 namespace threadingzeug
 {
@@ -8,7 +23,20 @@ namespace threadingzeug
 
 size_t getNumberOfThreads()
 {
-	return std::max(static_cast<size_t>(2), static_cast<size_t>(std::thread::hardware_concurrency()));
+    auto numberOfThreads = s_numberOfThreads.load();
+
+    if (numberOfThreads == 0)
+    {
+        numberOfThreads = Topology::current().numberOfThreads();
+        s_numberOfThreads = numberOfThreads;
+    }
+
+    return numberOfThreads;
+}
+
+void setNumberOfThreads(size_t numberOfThreads)
+{
+    s_numberOfThreads = numberOfThreads;
 }
 
 
@@ -0,0 +1,65 @@
+
+#include <iostream>
+#include <string>
+
+#include <loggingzeug/BinaryLogReader.h>
+#include <loggingzeug/ConsoleLogHandler.h>
+#include <loggingzeug/LogMessage.h>
+
+
+using namespace loggingzeug;
+
+
+namespace
+{
+
+
+// Writes all messages to stdout, prefixed as by the ConsoleLogHandler
+class OutputLogHandler : public ConsoleLogHandler
+{
+public:
+    virtual void handle(const LogMessage & message) override
+    {
+        std::cout << messagePrefix(message) << message.message() << '\n';
+    }
+};
+
+
+} // namespace
+
+
+int main(int argc, char * argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <binary log file>" << std::endl
+                  << "Converts a log file written by a loggingzeug::BinaryLogHandler to text." << std::endl;
+        return 1;
+    }
+
+    BinaryLogReader reader(argv[1]);
+
+    if (!reader.isValid())
+    {
+        std::cerr << "Not a binary log file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    OutputLogHandler handler;
+    auto record = LogRecord(LogMessage::Info, nullptr, std::string(), std::string());
+
+    while (reader.read(record))
+    {
+        handler.handleRecord(record);
+    }
+
+    std::cout.flush();
+
+    if (!reader.isValid())
+    {
+        std::cerr << "Truncated or corrupt binary log file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    return 0;
+}